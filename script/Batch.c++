@@ -0,0 +1,148 @@
+//Copyright(C) 2022-2023 by Brian Bronz
+#ifndef BATCH_H
+#define BATCH_H
+#include <string>
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include "main.h"
+using namespace std;
+
+/**
+ * @brief Constructor for the class BatchJob
+ *
+ * @param expression is the polynomial function f(x)
+ * @param interpolationForm is the form of the interpolation (Taylor or Lagrange)
+ * @param k is the order of convergence
+ * @param n is the level of convergence
+ * @param numThreads is the number of threads used by the Eval algorithm
+ */
+BatchJob::BatchJob(const string expression, const string interpolationForm, const int k, const int n, const int numThreads){
+    this->expression = expression;
+    this->interpolationForm = interpolationForm;
+    this->k = k;
+    this->n = n;
+    this->numThreads = numThreads;
+};
+
+/**
+ * @brief Run the tasks 0, ..., numTasks - 1 on a pool of threads
+ *
+ * @param numTasks is the number of tasks
+ * @param numWorkers is the number of threads
+ * @param task is the function executing a single task
+ */
+void RunPool(const int numTasks, const int numWorkers, const function<void(int)> task){
+    atomic<int> nextTask(0);
+    vector<thread> workers;
+    for (int i = 0; i < min(numWorkers, numTasks); i++){
+        workers.push_back(thread([&nextTask, numTasks, &task](){
+            //Each thread takes the next task until all the tasks are done
+            for (int j = nextTask++; j < numTasks; j = nextTask++){
+                task(j);
+            }
+        }));
+    }
+    for (int i = 0; i < workers.size(); i++){
+        workers[i].join();
+    }
+}
+
+/**
+ * @brief Solve a single job, writing the results with the same format of the serial run
+ *
+ * @param job is the job to solve
+ * @param coeffsFunc is the coefficients of the function f(x), empty if the expression cannot be parsed
+ * @param initialBound is the interval containing all real roots
+ * @param file is the file where the results are written
+ * @param timeFile is the file where the average time is written
+ * @param iterationFile is the file where the number of range function evaluations is written
+ */
+void SolveJob(const BatchJob &job, const vector<double> coeffsFunc, const Interval initialBound, ostream &file, ostream &timeFile, ostream &iterationFile){
+    file << "expression: " << job.expression << endl;
+    if (job.interpolationForm == "Lagrange"){
+        timeFile << endl;
+        iterationFile << endl;
+    }
+    //The expression of the job cannot be parsed
+    if (coeffsFunc.empty()){
+        file << "The expression cannot be parsed" << endl;
+    } else {
+        SolveRoots(coeffsFunc, initialBound, job.interpolationForm, job.k, job.n, job.numThreads, file, timeFile, iterationFile);
+    }
+    file << "The order of convergence is: " << job.k << " " << "the level is: " << job.n << endl;
+    file << endl;
+}
+
+/**
+ * @brief Solve all the jobs concurrently, parsing each distinct polynomial function only once
+ *
+ * @param jobs is the vector of jobs in the input order
+ * @param numWorkers is the number of threads solving the jobs
+ * @param file is the file where the results are written
+ * @param timeFile is the file where the average time is written
+ * @param iterationFile is the file where the number of range function evaluations is written
+ */
+void RunBatch(const vector<BatchJob> jobs, const int numWorkers, ostream &file, ostream &timeFile, ostream &iterationFile){
+    //Parse cache: index of each distinct expression
+    map<string, int> parsedIdx;
+    vector<string> expressions;
+    vector<int> jobPolynomial(jobs.size());
+    for (int i = 0; i < jobs.size(); i++){
+        if (parsedIdx.find(jobs[i].expression) == parsedIdx.end()){
+            parsedIdx[jobs[i].expression] = expressions.size();
+            expressions.push_back(jobs[i].expression);
+        }
+        jobPolynomial[i] = parsedIdx[jobs[i].expression];
+    }
+    //Parse and bound each distinct polynomial function
+    vector<vector<double> > coeffsFunc(expressions.size());
+    vector<Interval> initialBound(expressions.size(), Interval(0, 0));
+    RunPool(expressions.size(), numWorkers, [&](int i){
+        //The coefficients stay empty if the expression is not valid, its jobs fail
+        if (parseExpression(expressions[i], coeffsFunc[i])){
+            initialBound[i] = setInitialInterval(coeffsFunc[i]);
+        }
+    });
+    SolveBatch(jobs, jobPolynomial, coeffsFunc, initialBound, numWorkers, file, timeFile, iterationFile);
+}
+
+/**
+ * @brief Solve all the jobs concurrently, the polynomial functions are already parsed
+ *
+ * @param jobs is the vector of jobs in the input order
+ * @param jobPolynomial is the index of the polynomial function of each job
+ * @param coeffsFunc is the vector of the coefficients of each polynomial function
+ * @param initialBound is the vector of the intervals containing all real roots of each polynomial function
+ * @param numWorkers is the number of threads solving the jobs
+ * @param file is the file where the results are written
+ * @param timeFile is the file where the average time is written
+ * @param iterationFile is the file where the number of range function evaluations is written
+ */
+void SolveBatch(const vector<BatchJob> &jobs, const vector<int> &jobPolynomial, const vector<vector<double> > &coeffsFunc, const vector<Interval> &initialBound, const int numWorkers, ostream &file, ostream &timeFile, ostream &iterationFile){
+    //Solve the jobs, each of them writes in its own buffers
+    vector<ostringstream> jobFile(jobs.size()), jobTimeFile(jobs.size()), jobIterationFile(jobs.size());
+    for (int i = 1; i < jobs.size(); i++){
+        //The serial run leaves the streams in fixed notation after the first job
+        jobFile[i] << fixed << setprecision(5);
+        jobTimeFile[i] << fixed << setprecision(5);
+    }
+    RunPool(jobs.size(), numWorkers, [&](int i){
+        const int idx = jobPolynomial[i];
+        SolveJob(jobs[i], coeffsFunc[idx], initialBound[idx], jobFile[i], jobTimeFile[i], jobIterationFile[i]);
+    });
+    //Write the results in the input order
+    for (int i = 0; i < jobs.size(); i++){
+        file << jobFile[i].str();
+        timeFile << jobTimeFile[i].str();
+        iterationFile << jobIterationFile[i].str();
+    }
+}
+#endif
@@ -0,0 +1,150 @@
+//Copyright(C) 2022-2023 by Brian Bronz
+#ifndef COEFFICIENT_FILE_H
+#define COEFFICIENT_FILE_H
+#include <string>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "main.h"
+using namespace std;
+
+//First bytes of a binary coefficient file, followed by the records [int32 number of coefficients][coefficients as double]
+const char COEFFICIENT_MAGIC[8] = {'R', 'F', 'C', 'O', 'E', 'F', '0', '1'};
+
+/**
+ * @brief Parse a number of a plain-numeric row without reading past the end of the mapped file
+ *
+ * @param c is the first character of the number, it is moved after the number
+ * @param end is the end of the mapped file
+ * @param value is the parsed number
+ * @return true if a number was parsed
+ */
+bool parseNumber(const char *&c, const char *end, double &value){
+    const char *tokenEnd = c;
+    while (tokenEnd < end && !isspace(*tokenEnd)){tokenEnd++;}
+    char *next;
+    if (tokenEnd < end){
+        //strtod stops at the space after the number
+        value = strtod(c, &next);
+    } else {
+        //The last number of the file is not followed by any character
+        char buffer[64] = {0};
+        memcpy(buffer, c, min((long) (tokenEnd - c), 63L));
+        value = strtod(buffer, &next);
+        next = (char *) c + (next - buffer);
+    }
+    if (next == c){return false;}
+    c = next;
+    return true;
+}
+
+/**
+ * @brief Read all the polynomial functions of a coefficient file, mapping it in memory
+ *
+ * The file is either binary (see COEFFICIENT_MAGIC) or plain-numeric with one polynomial function for each row,
+ * the coefficients from the highest degree separated by spaces, like inputMatlab
+ *
+ * @param path is the path of the file
+ * @param coeffsFunc is the vector where the coefficients of all the functions are stored one after the other
+ * @param offsets is the vector of the index of the first coefficient of each function, plus the final size
+ * @return true if the file was read
+ */
+bool readCoefficientFile(const string path, vector<double> &coeffsFunc, vector<long> &offsets){
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1){return false;}
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == -1){
+        close(fd);
+        return false;
+    }
+    const long size = fileStat.st_size;
+    coeffsFunc.clear();
+    offsets.assign(1, 0);
+    if (size == 0){
+        close(fd);
+        return true;
+    }
+    void *mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED){return false;}
+    const char *c = (const char *) mapped;
+    const char *end = c + size;
+    if (size >= sizeof(COEFFICIENT_MAGIC) && memcmp(c, COEFFICIENT_MAGIC, sizeof(COEFFICIENT_MAGIC)) == 0){
+        //Binary records
+        c += sizeof(COEFFICIENT_MAGIC);
+        int32_t numCoeffs;
+        while (c + sizeof(numCoeffs) <= end){
+            memcpy(&numCoeffs, c, sizeof(numCoeffs));
+            c += sizeof(numCoeffs);
+            if (numCoeffs <= 0 || c + numCoeffs * sizeof(double) > end){break;}
+            const long start = coeffsFunc.size();
+            coeffsFunc.resize(start + numCoeffs);
+            memcpy(&coeffsFunc[start], c, numCoeffs * sizeof(double));
+            c += numCoeffs * sizeof(double);
+            offsets.push_back(coeffsFunc.size());
+        }
+    } else {
+        //Plain-numeric rows
+        while (c < end){
+            if (*c == '\n'){
+                //Close the row, if it has any coefficient
+                if (coeffsFunc.size() > offsets.back()){offsets.push_back(coeffsFunc.size());}
+                c++;
+            } else if (isspace(*c)){
+                c++;
+            } else {
+                double value;
+                if (parseNumber(c, end, value)){
+                    coeffsFunc.push_back(value);
+                } else {
+                    //Skip what is not a number
+                    while (c < end && !isspace(*c)){c++;}
+                }
+            }
+        }
+        if (coeffsFunc.size() > offsets.back()){offsets.push_back(coeffsFunc.size());}
+    }
+    munmap(mapped, size);
+    return true;
+}
+
+/**
+ * @brief Remove the leading zero coefficients of a row of a coefficient file, as parseExpression does
+ *
+ * @param coeffsFunc is the coefficients of the function f(x), from the highest degree
+ * @return true if the row has a nonzero coefficient, false if it is empty or all zeros
+ */
+bool normalizeCoefficients(vector<double> &coeffsFunc){
+    int first = 0;
+    while (first < coeffsFunc.size() && coeffsFunc[first] == 0){first++;}
+    if (first == coeffsFunc.size()){return false;}
+    coeffsFunc.erase(coeffsFunc.begin(), coeffsFunc.begin() + first);
+    return true;
+}
+
+/**
+ * @brief Write polynomial functions in a binary coefficient file
+ *
+ * @param path is the path of the file
+ * @param rows is the vector of the coefficients of each function, from the highest degree
+ */
+void writeCoefficientFile(const string path, const vector<vector<double> > rows){
+    ofstream file;
+    file.open(path, ios::binary);
+    file.write(COEFFICIENT_MAGIC, sizeof(COEFFICIENT_MAGIC));
+    for (int i = 0; i < rows.size(); i++){
+        const int32_t numCoeffs = rows[i].size();
+        file.write((const char *) &numCoeffs, sizeof(numCoeffs));
+        file.write((const char *) rows[i].data(), numCoeffs * sizeof(double));
+    }
+    file.close();
+}
+#endif
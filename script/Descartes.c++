@@ -0,0 +1,280 @@
+//Copyright(C) 2022-2023 by Brian Bronz
+#ifndef DESCARTES_H
+#define DESCARTES_H
+#include <string>
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <limits>
+#include <algorithm>
+#include "main.h"
+using namespace std;
+
+//Sign-variation pruning of the Eval algorithm, switched off by the "nopruning" option
+bool signPruning = true;
+
+/**
+ * @brief Count the sign variations of a sequence of coefficients, skipping the zeros
+ *
+ * @param coeffsFunc is the vector of coefficients
+ * @return int
+ */
+int signVariations(const vector<double> &coeffsFunc){
+    int variations = 0;
+    double lastSign = 0;
+    for (int i = 0; i < coeffsFunc.size(); i++){
+        if (coeffsFunc[i] == 0){continue;}
+        const double sign = (coeffsFunc[i] > 0) ? 1 : - 1;
+        if (lastSign * sign < 0){variations++;}
+        lastSign = sign;
+    }
+    return variations;
+}
+
+/**
+ * @brief Get the coefficients of f(-x)
+ *
+ * @param coeffsFunc is the coefficients of the function f(x), from the highest degree
+ * @return vector<double>
+ */
+vector<double> reflectedCoefficients(const vector<double> &coeffsFunc){
+    const int degree = coeffsFunc.size() - 1;
+    vector<double> reflected = coeffsFunc;
+    for (int i = 0; i <= degree; i++){
+        if ((degree - i) % 2 == 1){reflected[i] = - reflected[i];}
+    }
+    return reflected;
+}
+
+/**
+ * @brief Descartes' rule of signs: upper bound of the number of positive roots, with the same parity
+ *
+ * @param coeffsFunc is the coefficients of the function f(x)
+ * @return int
+ */
+int NumPositiveRoots(const vector<double> &coeffsFunc){
+    return signVariations(coeffsFunc);
+}
+
+/**
+ * @brief Descartes' rule of signs: upper bound of the number of negative roots, with the same parity
+ *
+ * @param coeffsFunc is the coefficients of the function f(x)
+ * @return int
+ */
+int NumNegativeRoots(const vector<double> &coeffsFunc){
+    return signVariations(reflectedCoefficients(coeffsFunc));
+}
+
+/**
+ * @brief Check with Descartes' rule of signs if the function can have real roots
+ *
+ * @param coeffsFunc is the coefficients of the function f(x)
+ * @return true if f(x) can have real roots
+ */
+bool existRealRoots(const vector<double> &coeffsFunc){
+    return coeffsFunc.back() == 0 || NumPositiveRoots(coeffsFunc) > 0 || NumNegativeRoots(coeffsFunc) > 0;
+}
+
+/**
+ * @brief Upper bound of the positive roots, the smaller of the Lagrange and Kioustelidis bounds
+ *
+ * Only the coefficients with the opposite sign of the leading one count: 1 + max |a_i / a_0| and 2 max |a_i / a_0|^(1/i)
+ *
+ * @param coeffsFunc is the coefficients of the function f(x)
+ * @return double, 0 if there are no positive roots
+ */
+double positiveRootBound(const vector<double> &coeffsFunc){
+    double maxRatio = 0;
+    double maxRoot = 0;
+    for (int i = 1; i < coeffsFunc.size(); i++){
+        const double ratio = coeffsFunc[i] / coeffsFunc[0];
+        if (ratio < 0){
+            maxRatio = max(maxRatio, - ratio);
+            maxRoot = max(maxRoot, pow(- ratio, 1.0 / i));
+        }
+    }
+    if (maxRatio == 0){return 0;}
+    return min(1 + maxRatio, 2 * maxRoot);
+}
+
+/**
+ * @brief Get the intervals where the subdivision starts, splitting the positive and the negative roots
+ *
+ * @param coeffsFunc is the coefficients of the function f(x)
+ * @param initialBound is the interval containing all real roots
+ * @return vector<Interval>
+ */
+vector<Interval> initialIntervals(const vector<double> &coeffsFunc, Interval initialBound){
+    //A root in 0 would be found in both the intervals
+    if (!signPruning || coeffsFunc.back() == 0){return {initialBound};}
+    vector<Interval> intervals;
+    if (NumNegativeRoots(coeffsFunc) > 0){
+        intervals.push_back(Interval(max(initialBound.a, - positiveRootBound(reflectedCoefficients(coeffsFunc))), 0));
+    }
+    if (NumPositiveRoots(coeffsFunc) > 0){
+        intervals.push_back(Interval(0, min(initialBound.b, positiveRootBound(coeffsFunc))));
+    }
+    return intervals;
+}
+
+//Largest number of subintervals transformed together, their Taylor shifts are independent and fill the SIMD lanes
+const int DESCARTES_LANES = 8;
+
+/**
+ * @brief Count the sign variations of (1 + x)^d f((a + b x) / (1 + x)) in the subintervals [a, b] of a block, an upper bound of the number of roots in (a, b) with the same parity
+ *
+ * The Taylor shifts are repeated on the absolute values of the coefficients to bound the rounding errors:
+ * the count is given up when the sign of a coefficient is not certain
+ *
+ * @tparam L is the number of subintervals of the block, known at compile time so that the loops on them are vectorized
+ * @param coeffsFunc is the coefficients of the function f(x)
+ * @param intervals is the first subinterval of the block
+ * @param variations is the first sign variation of the block, -1 if they cannot be counted safely
+ */
+template <int L>
+void blockSignVariations(const vector<double> &coeffsFunc, const Interval *intervals, int *variations){
+    const int degree = coeffsFunc.size() - 1;
+    //At most 4d + 1 roundings for each coefficient
+    const double gamma = (4 * degree + 4) * numeric_limits<double>::epsilon();
+    //Coefficients from the lowest degree and their absolute values, c[j * L + l] for the subinterval l of the block
+    vector<double> c((degree + 1) * L), m((degree + 1) * L);
+    double a[L], absA[L], w[L], wPower[L];
+    for (int l = 0; l < L; l++){
+        a[l] = intervals[l].a;
+        absA[l] = abs(intervals[l].a);
+        w[l] = intervals[l].b - intervals[l].a;
+        wPower[l] = 1;
+    }
+    for (int j = 0; j <= degree; j++){
+        for (int l = 0; l < L; l++){
+            c[j * L + l] = coeffsFunc[degree - j];
+            m[j * L + l] = abs(coeffsFunc[degree - j]);
+        }
+    }
+    //f(a + x)
+    for (int i = 0; i < degree; i++){
+        for (int j = degree - 1; j >= i; j--){
+            for (int l = 0; l < L; l++){
+                c[j * L + l] += a[l] * c[(j + 1) * L + l];
+                m[j * L + l] += absA[l] * m[(j + 1) * L + l];
+            }
+        }
+    }
+    //f(a + w x)
+    for (int j = 0; j <= degree; j++){
+        for (int l = 0; l < L; l++){
+            c[j * L + l] *= wPower[l];
+            m[j * L + l] *= wPower[l];
+            wPower[l] *= w[l];
+        }
+    }
+    //x^d f(a + w / x), then shift x -> 1 + x; the reversed coefficients are read from the end
+    for (int i = 0; i < degree; i++){
+        for (int j = 1; j <= degree - i; j++){
+            for (int l = 0; l < L; l++){
+                c[j * L + l] += c[(j - 1) * L + l];
+                m[j * L + l] += m[(j - 1) * L + l];
+            }
+        }
+    }
+    for (int l = 0; l < L; l++){
+        variations[l] = - 1;
+        //The width must be exact, otherwise the transformed polynomial belongs to another interval: error of b - a by TwoSum
+        const double bVirtual = w[l] + a[l];
+        const double aVirtual = w[l] - bVirtual;
+        if ((intervals[l].b - bVirtual) + (- a[l] - aVirtual) != 0){continue;}
+        int count = 0;
+        double lastSign = 0;
+        for (int j = degree; j >= 0 && count >= 0; j--){
+            const double coefficient = c[j * L + l];
+            const double magnitude = m[j * L + l];
+            if (!isfinite(coefficient) || !isfinite(magnitude)){
+                count = - 1;
+            } else if (magnitude == 0){
+                //The first and the last coefficients are f(b) and f(a): a root in an endpoint is not counted
+                if (j == 0 || j == degree){count = - 1;}
+            } else if (abs(coefficient) <= gamma * magnitude){
+                count = - 1;
+            } else {
+                const double sign = (coefficient > 0) ? 1 : - 1;
+                if (lastSign * sign < 0){count++;}
+                lastSign = sign;
+            }
+        }
+        variations[l] = count;
+    }
+}
+
+/**
+ * @brief Count the sign variations of (1 + x)^d f((a + b x) / (1 + x)) in all the subintervals [a, b], in blocks of 8, 4, 2 and 1 subintervals
+ *
+ * @param coeffsFunc is the coefficients of the function f(x)
+ * @param intervals is the vector of subintervals
+ * @param variations is the vector where the sign variations are written, -1 if they cannot be counted safely
+ */
+void intervalSignVariations(const vector<double> &coeffsFunc, const vector<Interval> &intervals, vector<int> &variations){
+    variations.assign(intervals.size(), - 1);
+    int first = 0;
+    for (; first + DESCARTES_LANES <= intervals.size(); first += DESCARTES_LANES){
+        blockSignVariations<DESCARTES_LANES>(coeffsFunc, &intervals[first], &variations[first]);
+    }
+    if (first + 4 <= intervals.size()){
+        blockSignVariations<4>(coeffsFunc, &intervals[first], &variations[first]);
+        first += 4;
+    }
+    if (first + 2 <= intervals.size()){
+        blockSignVariations<2>(coeffsFunc, &intervals[first], &variations[first]);
+        first += 2;
+    }
+    if (first < intervals.size()){
+        blockSignVariations<1>(coeffsFunc, &intervals[first], &variations[first]);
+    }
+}
+
+/**
+ * @brief Apply the sign-variation test to all the subintervals before the range functions
+ *
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param intervals is the vector of subintervals
+ * @param results is the vector where the results are written: 0 if the subinterval is discarded, 1 if it contains only one root
+ * and f(x) is monotone, 2 if the range functions must decide
+ */
+void descartesTest(const PolynomialContext &context, const vector<Interval> &intervals, vector<int> &results){
+    vector<int> variations;
+    intervalSignVariations(context.coeffsFunc, intervals, variations);
+    //Only one root: it is accepted if f'(x) has no roots, as the range functions guarantee
+    vector<Interval> single;
+    vector<int> singleIdx;
+    results.assign(intervals.size(), 2);
+    for (int p = 0; p < intervals.size(); p++){
+        if (variations[p] == 0){
+            results[p] = 0;
+        } else if (variations[p] == 1){
+            single.push_back(intervals[p]);
+            singleIdx.push_back(p);
+        }
+    }
+    if (single.empty()){return;}
+    intervalSignVariations(context.getDerivative(1), single, variations);
+    for (int p = 0; p < single.size(); p++){
+        if (variations[p] == 0){results[singleIdx[p]] = 1;}
+    }
+}
+
+/**
+ * @brief Apply the sign-variation test to a subinterval before the range functions
+ *
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param J is the subinterval
+ * @return int 0 if the subinterval is discarded, 1 if it contains only one root and f(x) is monotone, 2 if the range functions must decide
+ */
+int descartesTest(const PolynomialContext &context, Interval J){
+    int variations;
+    blockSignVariations<1>(context.coeffsFunc, &J, &variations);
+    if (variations == 0){return 0;}
+    if (variations != 1){return 2;}
+    blockSignVariations<1>(context.getDerivative(1), &J, &variations);
+    return (variations == 0) ? 1 : 2;
+}
+#endif
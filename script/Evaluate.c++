@@ -11,34 +11,8 @@
 #include "main.h"
 using namespace std;
 
-/**
- * @brief Using one of the implemented interpolations (Lagrange or Taylor) to compute the range function f(x), respectively f'(x)
- * 
- * @param a is the lower bound of the interval
- * @param b is the upper bound of the interval
- * @param coeffsFunc is the coefficients of the function f(x), respectively f^{'}(x)
- * @param formInterpolation is the form of the interpolation (Taylor or Lagrange)
- * @param k is the order of the convergence
- * @param n is the level of the convergence
- * @param dF is a boolean that indicates if the derivative function is used
- * @return Interval
- */
-Interval Interpolation(const double a, const double b, const vector<double> coeffsFunc, const string formInterpolation, const int k, const int n, const bool dF){
-    Interval I = Interval(a, b);
-    if (formInterpolation == "Taylor"){
-        //Taylor interpolation
-        TaylorInterpolation T = TaylorInterpolation(coeffsFunc, Interval(0, 0), a, b);
-        (dF)? I = T.getDf(I, n, k): I = T.getF(I, n, k);
-    } else if (formInterpolation == "Lagrange") {
-        //Lagrange interpolation
-        LagrangeInterpolation L = LagrangeInterpolation(coeffsFunc, 0, a, b);
-        (dF)? I = L.getDf(I, n, 3): I = L.getF(I, n, 3);
-    } else {
-        //Error
-        return Interval(0, 0);
-    }
-    return I;
-}
+//Number of derivatives computed by kDerivative
+thread_local double derivativeCounter = 0;
 
 /**
  * @brief Compute the k-derivate of the function
@@ -55,11 +29,12 @@ vector<double> kDerivative(vector<double> coeffsFunc, const int k){
         return {0};
     }
 
+    derivativeCounter++;
     //Calculate the k-derivate, resizing the coeffsFunc vector
     coeffsFunc.resize(sizeCoeffs - k);
     for (int i = 0; i < k; i++){
         //Calculate the new coeffsFunc of the function 
-        for (int j = 0; j < sizeCoeffs - i; j++){
+        for (int j = 0; j < coeffsFunc.size(); j++){
             coeffsFunc[j] = coeffsFunc[j] * (sizeCoeffs - j - 1);
         } 
         sizeCoeffs--;
@@ -74,7 +49,7 @@ vector<double> kDerivative(vector<double> coeffsFunc, const int k){
  * @param xPoint is a double point where the function is evaluated
  * @return double 
  */
-double functionValue(const vector<double> coeffsFunc, const double xPoint){
+double functionValue(const vector<double> &coeffsFunc, const double xPoint){
     double res = coeffsFunc[0];
     for (int i = 1; i < coeffsFunc.size(); i++){
         res = res * xPoint + coeffsFunc[i];
@@ -89,7 +64,7 @@ double functionValue(const vector<double> coeffsFunc, const double xPoint){
  * @param I is the interval of the function f(x)
  * @return Interval
  */
-Interval functionValue(const vector<double> coeffsFunc, Interval I){
+Interval functionValue(const vector<double> &coeffsFunc, Interval I){
      Interval res = Interval(coeffsFunc[0], coeffsFunc[0]);
      Interval I_m = Substraction(I, I.getMidpoint());
     for (int i = 1; i < coeffsFunc.size(); i++){
@@ -103,46 +78,200 @@ Interval functionValue(const vector<double> coeffsFunc, Interval I){
     return res;
 }
 
+/**
+ * @brief Get the range of the function in an interval, evaluating it with the Horner method in interval arithmetic
+ * 
+ * @param coeffsFunc is the coefficients of the function f(x)
+ * @param I is the interval
+ * @return Interval containing f(x) for all x in I
+ */
+Interval functionRange(const vector<double> &coeffsFunc, Interval I){
+    Interval res = Interval(coeffsFunc[0], coeffsFunc[0]);
+    for (int i = 1; i < coeffsFunc.size(); i++){
+        res = Sum(Multiplication(res, I), coeffsFunc[i]);
+    }
+    return res;
+}
+
+/**
+ * @brief Check if f(x) can vanish in a subinterval, by its range function and its values in the endpoints
+ *
+ * A range function not containing 0 must have the sign of f(a) and f(b): otherwise it misses a root in an endpoint
+ * by a rounding error, e.g. a root on the midpoint where two subintervals are split, and the root would be in neither.
+ * A root exactly on a split point belongs to the subinterval on its left, where it is b, so f(a) = 0 does not keep it
+ *
+ * @param range is the range function of f(x) in the subinterval [a, b]
+ * @param f_a is f(a)
+ * @param f_b is f(b)
+ * @return true if the subinterval can have a root
+ */
+bool canVanish(Interval range, const double f_a, const double f_b){
+    if (range.getA() < 0 && range.getB() > 0){return true;}
+    //A range reduced to a point is the one of an unknown form, it discards the subinterval
+    if (range.getA() == range.getB()){return false;}
+    return (range.getA() >= 0) ? (f_a < 0 || f_b <= 0) : (f_a > 0 || f_b >= 0);
+}
+
+/**
+ * @brief Apply the range function tests of the Eval algorithm to a single subinterval
+ * 
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param J is the subinterval
+ * @param kernel is the range function of the form and the order of convergence
+ * @param n is the level of convergence
+ * @param counter is the number of range function evaluations
+ * @return int 0 if the subinterval is discarded, 1 if it contains only one root, 2 if it must be divided
+ */
+int evalInterval(const PolynomialContext &context, Interval J, const RangeKernel &kernel, const int n, double &counter){
+    double a = J.a;
+    double b = J.b;
+    if (signPruning){
+        //The sign variations decide without the range functions
+        const int result = descartesTest(context, J);
+        if (result != 2){return result;}
+    }
+    //Compute the range function f(x) in the interval [a, b]
+    Interval funcInterval = kernel.pointRange(J, context, n, false);
+    counter++;
+    const double f_a = functionValue(context.coeffsFunc, a);
+    const double f_b = functionValue(context.coeffsFunc, b);
+    if (canVanish(funcInterval, f_a, f_b)){
+        //Compute the range function f'(x) in the interval [a, b]
+        Interval dFuncInterval = kernel.pointRange(J, context, n, true);
+        counter++;
+        if (dFuncInterval.getA() < 0 && dFuncInterval.getB() > 0){
+            //Divide the interval in two subintervals
+            return 2;
+        } else if (f_a * f_b < 0 || f_b == 0) {
+            //The subinterval contains only one root, a root on a split point is in the subinterval on its left
+            return 1;
+        }
+    }
+    return 0;
+}
+
 /**
  * @brief Get all the subintervals, each of them has only one root
  * 
- * @param coeffsFunc is the coefficient of the function f(x)
+ * @param context is the polynomial function f(x) with its derivatives
  * @param initialBound is the interval containing all real roots
  * @param formInterpolation is a string for Taylor or Lagrange interpolation
  * @param k is the order of convergence
  * @param n is the level of convergence
+ * @param numThreads is the number of threads, with more than one thread the subintervals are sorted
+ * @param counter is the number of range function evaluations
+ * @param derivativesPerInterval is the number of derivatives computed for each subinterval
  * @return vector<Interval> 
  */
-vector<Interval> Eval(const vector<double> coeffsFunc, Interval initialBound, const string formInterpolation, const int k, const int n, ofstream &iterationFile){
-    queue<Interval> Q;
-    Q.push(initialBound);
+vector<Interval> Eval(const PolynomialContext &context, Interval initialBound, const string formInterpolation, const int k, const int n, const int numThreads, double &counter, double &derivativesPerInterval){
+    counter = 0;
+    //The range functions are selected once, the subdivision loop does not depend on the form
+    const RangeKernel kernel(formInterpolation, k);
+    vector<Interval> freeIntervals;
+    vector<double> margins;
+    return EvalFrontier(context, initialIntervals(context.coeffsFunc, initialBound), kernel, n, numThreads, counter, derivativesPerInterval, freeIntervals, margins);
+}
+
+/**
+ * @brief Get all the subintervals with only one root, subdividing the given subintervals
+ *
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param frontier is the vector of disjoint subintervals where the subdivision starts
+ * @param kernel is the range function of the form and the order of convergence
+ * @param n is the level of convergence
+ * @param numThreads is the number of threads
+ * @param counter is the number of range function evaluations, the new ones are added
+ * @param derivativesPerInterval is the number of derivatives computed for each subinterval
+ * @param freeIntervals is the vector where the discarded subintervals are added, only with one thread
+ * @param margins is the vector where a lower bound of |f(x)| in each discarded subinterval is added, 0 if it is not known
+ * @return vector<Interval> sorted by the lower bound
+ */
+vector<Interval> EvalFrontier(const PolynomialContext &context, vector<Interval> frontier, const RangeKernel &kernel, const int n, const int numThreads, double &counter, double &derivativesPerInterval, vector<Interval> &freeIntervals, vector<double> &margins){
+    if (numThreads > 1){
+        return ParallelEval(context, frontier, kernel, n, numThreads, counter, derivativesPerInterval);
+    }
+    //Breadth-first subdivision, evaluating a whole level of subintervals at once
     vector<Interval> Z;
-    double counter = 0;
-    //create a new file to store the results
-    while(!Q.empty()){
-        Interval J = Q.front();
-        Q.pop();
-        double a = J.a;
-        double b = J.b;
-        //Compute the range function f(x) in the interval [a, b]
-        Interval funcInterval = Interpolation(a, b, coeffsFunc, formInterpolation, k, n, false);
-        counter++;
-        if (funcInterval.getA() < 0 && funcInterval.getB() > 0){
-            //Compute the range function f'(x) in the interval [a, b]
-            Interval dFuncInterval = Interpolation(a, b, coeffsFunc, formInterpolation, k, n, true);
-            counter++;
+    vector<Interval> funcIntervals, dFuncIntervals;
+    double numIntervals = 0;
+    const double initialDerivativeCounter = derivativeCounter;
+    profile.intervalsPushed += frontier.size();
+    while(!frontier.empty()){
+        numIntervals += frontier.size();
+        profile.maxQueueDepth = max(profile.maxQueueDepth, (double) frontier.size());
+        if (signPruning){
+            //The sign variations decide without the range functions, the other subintervals are left in the frontier
+            vector<Interval> undecided;
+            vector<int> results;
+            descartesTest(context, frontier, results);
+            for (int p = 0; p < frontier.size(); p++){
+                if (results[p] == 1){
+                    Z.push_back(frontier[p]);
+                } else if (results[p] == 2){
+                    undecided.push_back(frontier[p]);
+                } else {
+                    freeIntervals.push_back(frontier[p]);
+                    margins.push_back(0);
+                }
+            }
+            frontier.swap(undecided);
+        }
+        //Compute the range function f(x) in all the subintervals
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        kernel.frontierRange(frontier, context, n, false, funcIntervals);
+        profile.addRangeFunction(kernel.taylor, false, start);
+        counter += frontier.size();
+        //f(a) and f(b) of all the subintervals
+        vector<double> lower(frontier.size()), upper(frontier.size()), f_a, f_b;
+        for (int p = 0; p < frontier.size(); p++){
+            lower[p] = frontier[p].a;
+            upper[p] = frontier[p].b;
+        }
+        functionValues(context.coeffsFunc, lower, f_a);
+        functionValues(context.coeffsFunc, upper, f_b);
+        vector<Interval> candidates;
+        vector<int> candidateIdx;
+        for (int p = 0; p < frontier.size(); p++){
+            Interval funcInterval = funcIntervals[p];
+            if (canVanish(funcInterval, f_a[p], f_b[p])){
+                candidates.push_back(frontier[p]);
+                candidateIdx.push_back(p);
+            } else {
+                //The range function does not contain 0
+                freeIntervals.push_back(frontier[p]);
+                margins.push_back(max(funcInterval.getA(), - funcInterval.getB()));
+            }
+        }
+        //Compute the range function f'(x) in the subintervals where f(x) can vanish
+        start = chrono::steady_clock::now();
+        kernel.frontierRange(candidates, context, n, true, dFuncIntervals);
+        profile.addRangeFunction(kernel.taylor, true, start);
+        counter += candidates.size();
+        vector<Interval> nextFrontier;
+        for (int p = 0; p < candidates.size(); p++){
+            Interval dFuncInterval = dFuncIntervals[p];
+            const int i = candidateIdx[p];
             if (dFuncInterval.getA() < 0 && dFuncInterval.getB() > 0){
                 //Divide the interval in two subintervals
-                double m = (a + b) / 2;
-                Q.push(Interval(a, m));
-                Q.push(Interval(m, b));
-            } else if (functionValue(coeffsFunc, a) * functionValue(coeffsFunc, b) <= 0) {
-                //Store the subinterval that contains only one root
-                Z.push_back(Interval(a, b));
+                double m = (candidates[p].a + candidates[p].b) / 2;
+                nextFrontier.push_back(Interval(candidates[p].a, m));
+                nextFrontier.push_back(Interval(m, candidates[p].b));
+            } else if (f_a[i] * f_b[i] < 0 || f_b[i] == 0){
+                //The subinterval contains only one root, checking the sign of f(a) and f(b):
+                //a root on a split point is in the subinterval on its left
+                Z.push_back(candidates[p]);
+            } else {
+                //f(x) is monotone and does not change sign
+                freeIntervals.push_back(candidates[p]);
+                margins.push_back(min(abs(f_a[i]), abs(f_b[i])));
             }
         }
+        profile.intervalsPushed += nextFrontier.size();
+        frontier = nextFrontier;
     }
-    iterationFile << counter << " ";
+    derivativesPerInterval = (numIntervals > 0) ? (derivativeCounter - initialDerivativeCounter) / numIntervals : 0;
+    //The subintervals accepted by the sign variations come before the others of the same level
+    sort(Z.begin(), Z.end(), [](Interval I, Interval J){ return I.a < J.a; });
     return Z;
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,230 @@
+//Copyright(C) 2022-2023 by Brian Bronz
+#ifndef HORNER_H
+#define HORNER_H
+#include <string>
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <limits>
+#include <algorithm>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HORNER_X86
+#include <immintrin.h>
+#endif
+#include "main.h"
+using namespace std;
+
+//Kernels of the batched Horner method: 0 scalar, 1 AVX2, 2 AVX-512
+const int HORNER_SCALAR = 0;
+const int HORNER_AVX2 = 1;
+const int HORNER_AVX512 = 2;
+
+/**
+ * @brief Select the widest kernel supported by the processor
+ *
+ * @return int
+ */
+int detectHornerKernel(){
+#ifdef HORNER_X86
+    if (__builtin_cpu_supports("avx512f")){return HORNER_AVX512;}
+    if (__builtin_cpu_supports("avx2")){return HORNER_AVX2;}
+#endif
+    return HORNER_SCALAR;
+}
+
+//Kernel used by functionValues, selected at runtime
+int hornerKernel = detectHornerKernel();
+
+/**
+ * @brief Evaluate the function in the points x[from], ..., x[to - 1] using the Horner method
+ *
+ * @param coeffsFunc is the coefficients of the function f(x)
+ * @param x is the array of points
+ * @param res is the array where the values are stored
+ * @param from is the index of the first point
+ * @param to is the index after the last point
+ */
+void hornerScalar(const vector<double> &coeffsFunc, const double *x, double *res, const int from, const int to){
+    for (int p = from; p < to; p++){
+        res[p] = functionValue(coeffsFunc, x[p]);
+    }
+}
+
+/**
+ * @brief Evaluate the function in the intervals [a[from], b[from]], ..., [a[to - 1], b[to - 1]] centred in their midpoints
+ *
+ * @param coeffsFunc is the coefficients of the function f(x)
+ * @param a is the array of the lower bounds
+ * @param b is the array of the upper bounds
+ * @param resA is the array where the lower bounds of the values are stored
+ * @param resB is the array where the upper bounds of the values are stored
+ * @param from is the index of the first interval
+ * @param to is the index after the last interval
+ */
+void hornerScalar(const vector<double> &coeffsFunc, const double *a, const double *b, double *resA, double *resB, const int from, const int to){
+    for (int p = from; p < to; p++){
+        const Interval res = functionValue(coeffsFunc, Interval(a[p], b[p]));
+        resA[p] = res.a;
+        resB[p] = res.b;
+    }
+}
+
+#ifdef HORNER_X86
+/**
+ * @brief AVX2 version of the point Horner method, four points at a time
+ */
+__attribute__((target("avx2")))
+int hornerAVX2(const double *coeffsFunc, const int size, const double *x, double *res, const int numPoints){
+    int p = 0;
+    for (; p + 4 <= numPoints; p += 4){
+        const __m256d xPoint = _mm256_loadu_pd(x + p);
+        __m256d value = _mm256_set1_pd(coeffsFunc[0]);
+        for (int i = 1; i < size; i++){
+            //No fused multiply-add, to get the same rounding of the scalar method
+            value = _mm256_add_pd(_mm256_mul_pd(value, xPoint), _mm256_set1_pd(coeffsFunc[i]));
+        }
+        _mm256_storeu_pd(res + p, value);
+    }
+    return p;
+}
+
+/**
+ * @brief AVX2 version of the interval Horner method, four intervals at a time
+ */
+__attribute__((target("avx2")))
+int hornerAVX2(const double *coeffsFunc, const int size, const double *a, const double *b, double *resA, double *resB, const int numIntervals){
+    const __m256d two = _mm256_set1_pd(2.0);
+    int p = 0;
+    for (; p + 4 <= numIntervals; p += 4){
+        const __m256d lower = _mm256_loadu_pd(a + p);
+        const __m256d upper = _mm256_loadu_pd(b + p);
+        //I - m
+        const __m256d midpoint = _mm256_div_pd(_mm256_add_pd(lower, upper), two);
+        const __m256d c = _mm256_sub_pd(lower, midpoint);
+        const __m256d d = _mm256_sub_pd(upper, midpoint);
+        __m256d valueA = _mm256_set1_pd(coeffsFunc[0]);
+        __m256d valueB = valueA;
+        for (int i = 1; i < size; i++){
+            const __m256d ac = _mm256_mul_pd(valueA, c);
+            const __m256d ad = _mm256_mul_pd(valueA, d);
+            const __m256d bc = _mm256_mul_pd(valueB, c);
+            const __m256d bd = _mm256_mul_pd(valueB, d);
+            //min(x, y) and max(x, y) as in Multiplication: the operands are swapped to keep x when x == y
+            const __m256d minValue = _mm256_min_pd(_mm256_min_pd(bd, bc), _mm256_min_pd(ad, ac));
+            const __m256d maxValue = _mm256_max_pd(_mm256_max_pd(bd, bc), _mm256_max_pd(ad, ac));
+            const __m256d coeff = _mm256_set1_pd(coeffsFunc[i]);
+            valueA = _mm256_add_pd(minValue, coeff);
+            valueB = _mm256_add_pd(maxValue, coeff);
+        }
+        _mm256_storeu_pd(resA + p, valueA);
+        _mm256_storeu_pd(resB + p, valueB);
+    }
+    return p;
+}
+
+/**
+ * @brief AVX-512 version of the point Horner method, eight points at a time
+ */
+__attribute__((target("avx512f")))
+int hornerAVX512(const double *coeffsFunc, const int size, const double *x, double *res, const int numPoints){
+    int p = 0;
+    for (; p + 8 <= numPoints; p += 8){
+        const __m512d xPoint = _mm512_loadu_pd(x + p);
+        __m512d value = _mm512_set1_pd(coeffsFunc[0]);
+        for (int i = 1; i < size; i++){
+            value = _mm512_add_pd(_mm512_mul_pd(value, xPoint), _mm512_set1_pd(coeffsFunc[i]));
+        }
+        _mm512_storeu_pd(res + p, value);
+    }
+    return p;
+}
+
+/**
+ * @brief AVX-512 version of the interval Horner method, eight intervals at a time
+ */
+__attribute__((target("avx512f")))
+int hornerAVX512(const double *coeffsFunc, const int size, const double *a, const double *b, double *resA, double *resB, const int numIntervals){
+    const __m512d two = _mm512_set1_pd(2.0);
+    int p = 0;
+    for (; p + 8 <= numIntervals; p += 8){
+        const __m512d lower = _mm512_loadu_pd(a + p);
+        const __m512d upper = _mm512_loadu_pd(b + p);
+        const __m512d midpoint = _mm512_div_pd(_mm512_add_pd(lower, upper), two);
+        const __m512d c = _mm512_sub_pd(lower, midpoint);
+        const __m512d d = _mm512_sub_pd(upper, midpoint);
+        __m512d valueA = _mm512_set1_pd(coeffsFunc[0]);
+        __m512d valueB = valueA;
+        for (int i = 1; i < size; i++){
+            const __m512d ac = _mm512_mul_pd(valueA, c);
+            const __m512d ad = _mm512_mul_pd(valueA, d);
+            const __m512d bc = _mm512_mul_pd(valueB, c);
+            const __m512d bd = _mm512_mul_pd(valueB, d);
+            //The zero-masked min/max with a full mask, since _mm512_min_pd starts from an undefined vector
+            //and g++ 12 warns about it with -Wall
+            const __m512d minValue = _mm512_maskz_min_pd(0xFF, _mm512_maskz_min_pd(0xFF, bd, bc), _mm512_maskz_min_pd(0xFF, ad, ac));
+            const __m512d maxValue = _mm512_maskz_max_pd(0xFF, _mm512_maskz_max_pd(0xFF, bd, bc), _mm512_maskz_max_pd(0xFF, ad, ac));
+            const __m512d coeff = _mm512_set1_pd(coeffsFunc[i]);
+            valueA = _mm512_add_pd(minValue, coeff);
+            valueB = _mm512_add_pd(maxValue, coeff);
+        }
+        _mm512_storeu_pd(resA + p, valueA);
+        _mm512_storeu_pd(resB + p, valueB);
+    }
+    return p;
+}
+#endif
+
+/**
+ * @brief Evaluate the function in many points using the Horner method
+ *
+ * @param coeffsFunc is the coefficients of the function f(x)
+ * @param xPoints is the vector of points where the function is evaluated
+ * @param values is the vector where the values are stored
+ */
+void functionValues(const vector<double> &coeffsFunc, const vector<double> &xPoints, vector<double> &values){
+    const int numPoints = xPoints.size();
+    values.resize(numPoints);
+    int done = 0;
+#ifdef HORNER_X86
+    if (hornerKernel == HORNER_AVX512){
+        done = hornerAVX512(coeffsFunc.data(), coeffsFunc.size(), xPoints.data(), values.data(), numPoints);
+    } else if (hornerKernel == HORNER_AVX2){
+        done = hornerAVX2(coeffsFunc.data(), coeffsFunc.size(), xPoints.data(), values.data(), numPoints);
+    }
+#endif
+    //Remaining points
+    hornerScalar(coeffsFunc, xPoints.data(), values.data(), done, numPoints);
+}
+
+/**
+ * @brief Get the intervals of many subintervals, evaluating the function in their midpoints
+ *
+ * @param coeffsFunc is the coefficients of the function f(x)
+ * @param lower is the vector of the lower bounds of the subintervals
+ * @param upper is the vector of the upper bounds of the subintervals
+ * @param resLower is the vector where the lower bounds of the intervals are stored
+ * @param resUpper is the vector where the upper bounds of the intervals are stored
+ */
+void functionValues(const vector<double> &coeffsFunc, const vector<double> &lower, const vector<double> &upper, vector<double> &resLower, vector<double> &resUpper){
+    const int numIntervals = lower.size();
+    resLower.resize(numIntervals);
+    resUpper.resize(numIntervals);
+    int done = 0;
+#ifdef HORNER_X86
+    if (hornerKernel == HORNER_AVX512){
+        done = hornerAVX512(coeffsFunc.data(), coeffsFunc.size(), lower.data(), upper.data(), resLower.data(), resUpper.data(), numIntervals);
+    } else if (hornerKernel == HORNER_AVX2){
+        done = hornerAVX2(coeffsFunc.data(), coeffsFunc.size(), lower.data(), upper.data(), resLower.data(), resUpper.data(), numIntervals);
+    }
+    //Same degenerate case of the scalar method
+    for (int p = 0; p < done; p++){
+        if (resLower[p] == resUpper[p]){
+            resLower[p] = - abs(resLower[p]);
+            resUpper[p] = abs(resUpper[p]);
+        }
+    }
+#endif
+    //Remaining intervals
+    hornerScalar(coeffsFunc, lower.data(), upper.data(), resLower.data(), resUpper.data(), done, numIntervals);
+}
+#endif
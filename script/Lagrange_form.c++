@@ -7,95 +7,20 @@
 #include <limits>
 #include "Evaluate.c++"
 #include "Interval.c++"
-#include "Range_function.c++"
 #include "main.h"
 using namespace std;
 
-/**
- * @brief Constructor for the class LagrangeInterpolation
- * 
- * @param coeffsFunc is the vector of coefficients of the function f(x)
- * @param approxInterval is the sum of the approximate part of the Lagrange polynomial
- * @param a is the lower bound of the interval
- * @param b is the upper bound of the interval
- */
-LagrangeInterpolation::LagrangeInterpolation(const vector<double> coeffsFunc, const double approxInterval, const double a, const double b): RangeFunc(a, b){
-    this->coeffsFunc = coeffsFunc;
-    this->approxInterval = approxInterval;
-};
-
-/**
- * @brief Define the coefficients of the exact part of the Lagrange polynomial
- * 
- * @param j is the index of the Lagrange polynomial
- * @param I is the interval
- * @return vector<double> 
- */
-vector<double> LagrangeInterpolation::h_j(const int j, Interval I){
-    double r = I.getRadius();
-    vector<double> cDerivative = kDerivative(coeffsFunc, 3 * j);
-    //Compute f(a), f(m), f(b)
-    double f_a = functionValue(cDerivative, I.getA());
-    double f_m = functionValue(cDerivative, I.getMidpoint());
-    double f_b = functionValue(cDerivative, I.getB());
-    //coefficients d_{j,0}, d_{j,1}, d_{j,2}
-    double d_j_0 = f_m;
-    double d_j_1 = (f_b - f_a) / (2.0 * r); 
-    double d_j_2 = (f_b - 2.0 * f_m + f_a) / (2.0 * r * r);
-    //h_{j}(I) = d_j_2 * (x - m)^2 + d_j_1 * (x - m) + d_j_0
-    return {d_j_0, d_j_1, d_j_2};
-};
-
-/**
- * @brief Define the T_{k,n}(I) for the Lagrange polynomial
- * 
- * @param n is the level of convergence
- * @param I is the interval
- * @return double 
- */
-double LagrangeInterpolation::T_kn(const int n, Interval I){
-    const double r = I.getRadius();
-    double Omega3 = (r * r * r * sqrt(3.0))/ 27.0;
-    const double initialOmega3 = Omega3;
-    int j = 1;
-    //sum_{j=1}^{n-1} Omega3^j * |h_{j}(I)|
-    while (j < n && 3 * j <= coeffsFunc.size() - 1){
-        //Compute the h_{j}(I)
-        vector<double> temp_h_j = h_j(j, I);
-        
-        Interval tempInterval = quadratic_polynomials(I, temp_h_j);
-        //Compute the magnitude of h_{j}(I)
-        double magnitude_h_j = max(abs(tempInterval.getA()), abs(tempInterval.getB()));
-        //Omega3^j
-        if (j != 1){Omega3 *= initialOmega3;}
-        approxInterval += Omega3 * magnitude_h_j;
-        j++;
-    }
-    //Omega3^n * |f^{3n}(I)|
-    if (3 * n <= coeffsFunc.size() - 1){
-        vector<double> cDerivative = kDerivative(coeffsFunc, 3 * n);
-        Interval tempInterval = functionValue(cDerivative, I);
-        double magnitude_c_derivate = max(abs(tempInterval.getA()), abs(tempInterval.getB()));
-        approxInterval += magnitude_c_derivate * Omega3 * initialOmega3;
-    }
-    //T_{3,n}(I):= sum_{j=1}^{n-1} Omega3^j * |h_{j}(I)| + Omega3^n * |f^{3n}(I)|
-    return approxInterval;
-};
-
 /**
  * @brief Define the quadratic polynomials to obtain the interval for the exact part of the Lagrange polynomial
- * 
- * @param I is the interval
- * @param h_0 is the vector containing the coefficients of the exact part of the Lagrange polynomial
+ *
+ * @param r is the radius of the interval
+ * @param c0 is the coefficient of degree 0 of h(x - m)
+ * @param c1 is the coefficient of degree 1 of h(x - m)
+ * @param c2 is the coefficient of degree 2 of h(x - m)
  * @return Interval
  */
-Interval LagrangeInterpolation::quadratic_polynomials(Interval I, const vector<double> h_0){
+Interval quadraticRange(const double r, const double c0, const double c1, const double c2){
     Interval interval(0, 0);
-    //Set the radius of the interval
-    double r = I.getRadius();
-    double c0 = h_0[0];
-    double c1 = h_0[1];
-    double c2 = h_0[2];
     //Compute the interval
     double value_a = c0 + (- c1 + c2 * r) * r;
     double value_b = c0 + (c1 + c2 * r) * r;
@@ -108,40 +33,108 @@ Interval LagrangeInterpolation::quadratic_polynomials(Interval I, const vector<d
         } else {
             interval.b = gxValue;
         }
-    } 
+    }
     return interval;
-};
+}
 
 /**
- * @brief Get the range function f(x)
- * 
- * @param I is an interval
- * @param n is an integer number for the level of convergence
- * @param k is an integer number for the order of convergence
- * @return vector<double> 
+ * @brief Get the range function f(x), respectively f'(x), in the Lagrange form of order 3
+ *
+ * @tparam Df is true if the derivative of the function is needed
+ * @param f_a gives f^{(3j)}(a)
+ * @param f_m gives f^{(3j)}(m)
+ * @param f_b gives f^{(3j)}(b)
+ * @param remainder is the interval of f^{(3n)}(I), used if 3n is not above the degree
+ * @param I is the interval
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param n is the level of convergence
+ * @return Interval
  */
-Interval LagrangeInterpolation::getF(Interval I, const int n, const int k){
-    vector<double> h_0 = h_j(0, I);
-    approxInterval = T_kn(n, I);
-    //Set the function coeffsFunc with the exact part of the function
-    Interval exactInterval = quadratic_polynomials(I, h_0);
+template <bool Df, class Values>
+Interval lagrangeRange(const Values &f_a, const Values &f_m, const Values &f_b, Interval remainder, Interval I, const PolynomialContext &context, const int n){
+    const double r = I.getRadius();
+    double Omega3 = (r * r * r * sqrt(3.0))/ 27.0;
+    const double initialOmega3 = Omega3;
+    //T_{3,n}(I):= sum_{j=1}^{n-1} Omega3^j * |h_{j}(I)| + Omega3^n * |f^{3n}(I)|
+    double approxInterval = 0;
+    for (int j = 1; j < n && 3 * j <= context.degree; j++){
+        //h_{j}(I) = d_j_2 * (x - m)^2 + d_j_1 * (x - m) + d_j_0
+        const double d_j_1 = (f_b(j) - f_a(j)) / (2.0 * r);
+        const double d_j_2 = (f_b(j) - 2.0 * f_m(j) + f_a(j)) / (2.0 * r * r);
+        Interval tempInterval = quadraticRange(r, f_m(j), d_j_1, d_j_2);
+        //Compute the magnitude of h_{j}(I)
+        double magnitude_h_j = max(abs(tempInterval.getA()), abs(tempInterval.getB()));
+        //Omega3^j
+        if (j != 1){Omega3 *= initialOmega3;}
+        approxInterval += Omega3 * magnitude_h_j;
+    }
+    if (3 * n <= context.degree){
+        double magnitude_c_derivate = max(abs(remainder.getA()), abs(remainder.getB()));
+        //Omega3^n, the loop stops at Omega3^{n-1} and does not run for n = 1; an overflow leaves the remainder unbounded
+        const double Omega3n = (n == 1) ? initialOmega3 : Omega3 * initialOmega3;
+        approxInterval = (isfinite(magnitude_c_derivate)) ? approxInterval + magnitude_c_derivate * Omega3n : numeric_limits<double>::infinity();
+    }
+    //coefficients d_{0,0}, d_{0,1}, d_{0,2} of h_{0}(I)
+    const double d_0_0 = f_m(0);
+    const double d_0_1 = (f_b(0) - f_a(0)) / (2.0 * r);
+    const double d_0_2 = (f_b(0) - 2.0 * f_m(0) + f_a(0)) / (2.0 * r * r);
+    if (Df){
+        const double flag = (3.0 * sqrt(3.0)) / r;
+        Interval exactInterval = quadraticRange(r, d_0_1, 2 * d_0_2, 0);
+        return Interval(exactInterval.a - approxInterval * flag, exactInterval.b + approxInterval * flag);
+    }
+    Interval exactInterval = quadraticRange(r, d_0_0, d_0_1, d_0_2);
     return Interval(exactInterval.a - approxInterval, exactInterval.b + approxInterval);
 }
 
 /**
- * @brief Get the range function f^{'}(x)
- * 
- * @param I is an interval
- * @param n is an integer number for the level of convergence
- * @param k is an integer number for the order of convergence
- * @return vector<double>
+ * @brief Compute the range function f(x), respectively f'(x), in all the subintervals of a frontier with the Lagrange form
+ *
+ * @param frontier is the vector of subintervals
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param n is the level of the convergence
+ * @param dF is a boolean that indicates if the derivative function is used
+ * @param ranges is the vector where the range functions are written
+ */
+void lagrangeFrontier(const vector<Interval> &frontier, const PolynomialContext &context, const int n, const bool dF, vector<Interval> &ranges){
+    const int numIntervals = frontier.size();
+    vector<double> lower(numIntervals), upper(numIntervals), midpoints(numIntervals);
+    for (int p = 0; p < numIntervals; p++){
+        lower[p] = frontier[p].a;
+        upper[p] = frontier[p].b;
+        midpoints[p] = (frontier[p].a + frontier[p].b) / 2;
+    }
+    //f^{(3j)}(a), f^{(3j)}(m), f^{(3j)}(b) for all the subintervals, j = 0, ..., n - 1
+    const int numOrders = min(max(n - 1, 0), context.degree / 3) + 1;
+    vector<vector<double> > valuesA(numOrders), valuesM(numOrders), valuesB(numOrders);
+    for (int j = 0; j < numOrders; j++){
+        const vector<double> &cDerivative = context.getDerivative(3 * j);
+        functionValues(cDerivative, lower, valuesA[j]);
+        functionValues(cDerivative, midpoints, valuesM[j]);
+        functionValues(cDerivative, upper, valuesB[j]);
+    }
+    ranges.resize(numIntervals, Interval(0, 0));
+    for (int p = 0; p < numIntervals; p++){
+        const FrontierValues f_a(valuesA, p), f_m(valuesM, p), f_b(valuesB, p);
+        //f^{(3n)}(I) in the whole subinterval
+        const Interval remainder = (3 * n <= context.degree) ? functionRange(context.getDerivative(3 * n), frontier[p]) : Interval(0, 0);
+        ranges[p] = (dF) ? lagrangeRange<true>(f_a, f_m, f_b, remainder, frontier[p], context, n)
+            : lagrangeRange<false>(f_a, f_m, f_b, remainder, frontier[p], context, n);
+    }
+}
+
+/**
+ * @brief Compute the range function f(x), respectively f'(x), in a single interval with the Lagrange form
+ *
+ * @param I is the interval
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param n is the level of the convergence
+ * @param dF is a boolean that indicates if the derivative function is used
+ * @return Interval
  */
-Interval LagrangeInterpolation::getDf(Interval I, const int n, const int k){
-    const vector<double> h_0_d = h_j(0, I);
-    vector<double> hDerivative = {h_0_d[1], 2 * h_0_d[2], 0};
-    approxInterval = T_kn(n, I);
-    const double flag = (3.0 * sqrt(3.0)) / I.getRadius();
-    Interval exactInterval = quadratic_polynomials(I, hDerivative);
-    return Interval(exactInterval.a - approxInterval * flag, exactInterval.b + approxInterval * flag);
+Interval lagrangePoint(Interval I, const PolynomialContext &context, const int n, const bool dF){
+    const PointValues f_a(context, 3, I.getA()), f_m(context, 3, I.getMidpoint()), f_b(context, 3, I.getB());
+    const Interval remainder = (3 * n <= context.degree) ? functionRange(context.getDerivative(3 * n), I) : Interval(0, 0);
+    return (dF) ? lagrangeRange<true>(f_a, f_m, f_b, remainder, I, context, n) : lagrangeRange<false>(f_a, f_m, f_b, remainder, I, context, n);
 }
-#endif
\ No newline at end of file
+#endif
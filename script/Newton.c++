@@ -8,51 +8,148 @@
 using namespace std;
 
 /**
- * @brief Find the real roots of a function using the Newton method
- * 
- * @param coeffsFunc is the coefficients of the function f(x)
- * @param Z is a vector containing the subintervals
+ * @brief Constructor for the class Root
+ *
+ * @param value is the approximation of the root
+ * @param a is the lower bound of the bracket containing the root
+ * @param b is the upper bound of the bracket containing the root
+ */
+Root::Root(const double value, const double a, const double b){
+    this->value = value;
+    this->a = a;
+    this->b = b;
+    this->iterations = 0;
+    this->residual = numeric_limits<double>::infinity();
+    this->converged = false;
+};
+
+/**
+ * @brief Refine all the isolating subintervals at once with a safeguarded Newton-bisection method
+ *
+ * In every iteration f(x) and f'(x) are evaluated in the current iterates of all the subintervals not yet converged,
+ * using the batched Horner's method. Each subinterval keeps a bracket [a, b] with the root and f(a), f(b), evaluated once
+ * at the start: a root in an endpoint is accepted at once and their signs tell on which side of an iterate the root is.
+ * The Newton step is taken when it falls inside the bracket and reduces the step enough; a step overshooting the bracket
+ * is replaced by the secant of the bracket, which lands on the endpoint next to the root when the root is within rounding
+ * of it, and a step not reducing enough by the bisection, so every root converges even where f'(x) is small
+ *
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param Z is the vector of subintervals, each of them has only one root and f(x) is monotone in it
  * @param maxIterations is the maximum number of iterations
  * @param tolerance is the tolerance of the method
- * @param epsilon is the tolerance of the derivative
- * @param firstIteration is a boolean that indicates if it is the first iteration and if the results must be written in a file
- * @param file is the file where the results are written
+ * @return vector<Root> in the same order of Z, the residual is |f(x)| in the last evaluated iterate
  */
-void getRoots(const vector<double> coeffsFunc, vector<Interval> Z, const int maxIterations, const double tolerance, const double epsilon, const bool firstIteration, ofstream &file){
-    const vector<double> cDerivative = kDerivative(coeffsFunc, 1);;
+vector<Root> refineRoots(const PolynomialContext &context, const vector<Interval> &Z, const int maxIterations, const double tolerance){
+    vector<double> start(Z.size());
     for (int i = 0; i < Z.size(); i++){
-        double x0 = Z[i].getMidpoint();
-        double res = functionValue(cDerivative, x0);
-        if (res == 0){
-            //change the initial guess
-            x0 = Z[i].getA();
+        Interval I = Z[i];
+        start[i] = I.getMidpoint();
+    }
+    return refineRoots(context, Z, start, maxIterations, tolerance);
+}
+
+/**
+ * @brief Refine all the isolating subintervals at once, starting the iterations from the given points
+ *
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param Z is the vector of subintervals, each of them has only one root and f(x) is monotone in it
+ * @param start is the first iterate of each subinterval, the midpoint is used if it is outside the subinterval
+ * @param maxIterations is the maximum number of iterations
+ * @param tolerance is the tolerance of the method
+ * @return vector<Root> in the same order of Z, the residual is |f(x)| in the last evaluated iterate
+ */
+vector<Root> refineRoots(const PolynomialContext &context, const vector<Interval> &Z, const vector<double> &start, const int maxIterations, const double tolerance){
+    const vector<double> &coeffsFunc = context.coeffsFunc;
+    const vector<double> &cDerivative = context.getDerivative(1);
+    const int numRoots = Z.size();
+    vector<Root> roots;
+    //Length of the last two steps and sign of f'(x) in each subinterval, 0 until it is known
+    vector<double> lastStep(numRoots), previousStep(numRoots);
+    vector<int> direction(numRoots, 0);
+    vector<int> active, nextActive;
+    //f(a) and f(b) of all the brackets
+    vector<double> lower(numRoots), upper(numRoots), f_a, f_b;
+    for (int i = 0; i < numRoots; i++){
+        lower[i] = Z[i].a;
+        upper[i] = Z[i].b;
+    }
+    functionValues(coeffsFunc, lower, f_a);
+    functionValues(coeffsFunc, upper, f_b);
+    for (int i = 0; i < numRoots; i++){
+        Interval I = Z[i];
+        const double x0 = (start[i] >= I.getA() && start[i] <= I.getB()) ? start[i] : I.getMidpoint();
+        roots.push_back(Root(x0, I.getA(), I.getB()));
+        lastStep[i] = I.getWidth();
+        previousStep[i] = I.getWidth();
+        if (f_a[i] == 0 || f_b[i] == 0){
+            //The root is an endpoint
+            roots[i].value = (f_a[i] == 0) ? I.getA() : I.getB();
+            roots[i].residual = 0;
+            roots[i].converged = true;
+            continue;
         }
-        double x_old = x0;
-        double x1;
-        double iteration = 0;
-        //Set the bounds of the interval
-        const double a = Z[i].getA();
-        const double b = Z[i].getB();
-        while (iteration < maxIterations){
-            //Compute the value of the function and its derivative
-            double y0 = functionValue(coeffsFunc, x_old);
-            double yDerivative = functionValue(cDerivative, x_old);
-            if (yDerivative == 0 || abs(yDerivative) < epsilon){ break;}
-            //Compute the new value of x
-            x1 = x_old - y0 / yDerivative;
-            if (abs(x1 - x_old) < tolerance){break;}
-            //Update the values of x_old and iteration
-            x_old = x1;
-            if (x1 < a || x1 > b || x_old > b || x_old < a){break;}
-            iteration++;
+        //f(x) is monotone in the subinterval: f(x) has the sign of f(b) above the root
+        if (f_a[i] * f_b[i] < 0){direction[i] = (f_b[i] > 0) ? 1 : - 1;}
+        active.push_back(i);
+    }
+    vector<double> x, y, yDerivative;
+    while (!active.empty()){
+        //Compute the value of the function and its derivative in all the iterates
+        x.resize(active.size());
+        for (int p = 0; p < active.size(); p++){
+            x[p] = roots[active[p]].value;
         }
-        if (iteration == maxIterations && abs(x1 - x_old) > tolerance){
-            break;
-        } else {
-            //write the root and the interval in the file
-            if (firstIteration){
-                file << "The root is " << x1 << " in the interval [" << a << ", " << b << "]" " in "<< iteration << " iterations" << endl;
+        functionValues(coeffsFunc, x, y);
+        functionValues(cDerivative, x, yDerivative);
+        nextActive.clear();
+        for (int p = 0; p < active.size(); p++){
+            const int i = active[p];
+            Root &root = roots[i];
+            root.iterations++;
+            root.residual = abs(y[p]);
+            if (y[p] == 0){
+                root.converged = true;
+                continue;
+            }
+            if (direction[i] == 0){
+                //f(a) and f(b) have the same sign: the sign of f'(x) tells on which side the root is
+                direction[i] = (yDerivative[p] > 0) - (yDerivative[p] < 0);
+                if (direction[i] == 0){
+                    direction[i] = (f_b[i] >= 0) ? 1 : - 1;
+                }
+            }
+            //Shrink the bracket
+            if (y[p] * direction[i] > 0){
+                root.b = x[p];
+                f_b[i] = y[p];
+            } else {
+                root.a = x[p];
+                f_a[i] = y[p];
+            }
+            //Newton step, replaced by the secant of the bracket if it leaves the bracket,
+            //and by the bisection if it is not half the step before the last one
+            double x1 = x[p] - y[p] / yDerivative[p];
+            if (!(x1 >= root.a && x1 <= root.b) && f_a[i] * f_b[i] < 0){
+                x1 = root.a - f_a[i] * (root.b - root.a) / (f_b[i] - f_a[i]);
+                //A secant on an endpoint means the root is within rounding of it: shrink the bracket to it
+                if (!(x1 > root.a && x1 < root.b)){x1 = (abs(f_a[i]) < abs(f_b[i])) ? root.a : root.b;}
+            } else if (!(x1 >= root.a && x1 <= root.b) || abs(2 * y[p]) > abs(previousStep[i] * yDerivative[p])){
+                x1 = (root.a + root.b) / 2;
+            }
+            previousStep[i] = lastStep[i];
+            lastStep[i] = x1 - x[p];
+            root.value = x1;
+            if (abs(lastStep[i]) < tolerance || root.b - root.a < tolerance){
+                root.converged = true;
+            } else if (root.iterations < maxIterations){
+                nextActive.push_back(i);
             }
         }
+        active.swap(nextActive);
+    }
+    for (int i = 0; i < numRoots; i++){
+        profile.numRoots += roots[i].converged;
+        profile.newtonIterations += roots[i].iterations;
     }
-} 
+    return roots;
+}
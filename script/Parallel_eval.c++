@@ -0,0 +1,175 @@
+//Copyright(C) 2022-2023 by Brian Bronz
+#ifndef PARALLEL_EVAL_H
+#define PARALLEL_EVAL_H
+#include <string>
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <limits>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <algorithm>
+#include "main.h"
+using namespace std;
+
+/**
+ * @brief Push a subinterval at the back of the deque, used by the owner thread
+ *
+ * @param I is the subinterval
+ */
+void WorkDeque::push(Interval I){
+    lock_guard<mutex> guard(lock);
+    intervals.push_back(I);
+};
+
+/**
+ * @brief Pop the last subinterval of the deque, used by the owner thread
+ *
+ * @param I is the popped subinterval
+ * @return true if the deque was not empty
+ */
+bool WorkDeque::pop(Interval &I){
+    lock_guard<mutex> guard(lock);
+    if (intervals.empty()){return false;}
+    I = intervals.back();
+    intervals.pop_back();
+    return true;
+};
+
+/**
+ * @brief Steal the first subinterval of the deque, the widest one, used by the other threads
+ *
+ * @param I is the stolen subinterval
+ * @return true if the deque was not empty
+ */
+bool WorkDeque::steal(Interval &I){
+    lock_guard<mutex> guard(lock);
+    if (intervals.empty()){return false;}
+    I = intervals.front();
+    intervals.pop_front();
+    return true;
+};
+
+/**
+ * @brief Constructor for the class WorkSignal
+ *
+ * @param pending is the number of subintervals pushed in the deques before the threads start
+ */
+WorkSignal::WorkSignal(const long pending) : waiting(0), pending(pending), queued(pending){
+};
+
+/**
+ * @brief Sleep until a subinterval is pushed in a deque or all the subintervals are evaluated
+ */
+void WorkSignal::wait(){
+    unique_lock<mutex> guard(lock);
+    waiting++;
+    changed.wait(guard, [this](){ return queued.load() > 0 || pending.load() == 0; });
+    waiting--;
+};
+
+/**
+ * @brief Wake the sleeping threads, after pushing subintervals or evaluating the last one
+ */
+void WorkSignal::notify(){
+    if (waiting.load() == 0){return;}
+    //Taking the lock orders the change before the check of a thread going to sleep
+    {lock_guard<mutex> guard(lock);}
+    changed.notify_all();
+};
+
+/**
+ * @brief Subdivide the subintervals of one thread, stealing from the other threads when its deque is empty
+ *
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param kernel is the range function of the form and the order of convergence
+ * @param n is the level of convergence
+ * @param deques is the vector containing the deque of each thread
+ * @param id is the index of the thread
+ * @param signal is the number of subintervals pushed and not yet evaluated, waking the idle threads
+ * @param Z is the vector where the subintervals with only one root are stored
+ * @param counter is the number of range function evaluations of the thread
+ * @param numIntervals is the number of subintervals evaluated by the thread
+ * @param numDerivatives is the number of derivatives computed by the thread
+ */
+void EvalWorker(const PolynomialContext &context, const RangeKernel &kernel, const int n, vector<WorkDeque> &deques, const int id, WorkSignal &signal, vector<Interval> &Z, double &counter, double &numIntervals, double &numDerivatives){
+    const int numThreads = deques.size();
+    const double initialDerivativeCounter = derivativeCounter;
+    Interval J = Interval(0, 0);
+    while (signal.pending.load() > 0){
+        bool found = deques[id].pop(J);
+        //Steal from the other threads, starting from the next one
+        for (int i = 1; i < numThreads && !found; i++){
+            found = deques[(id + i) % numThreads].steal(J);
+        }
+        if (!found){
+            signal.wait();
+            continue;
+        }
+        signal.queued--;
+        numIntervals++;
+        const int result = evalInterval(context, J, kernel, n, counter);
+        if (result == 2){
+            //Divide the interval in two subintervals, counting them before J is completed
+            double m = (J.a + J.b) / 2;
+            signal.pending += 2;
+            signal.queued += 2;
+            deques[id].push(Interval(J.a, m));
+            deques[id].push(Interval(m, J.b));
+            signal.notify();
+        } else if (result == 1){
+            //Store the subinterval that contains only one root
+            Z.push_back(J);
+        }
+        if (--signal.pending == 0){signal.notify();}
+    }
+    numDerivatives = derivativeCounter - initialDerivativeCounter;
+}
+
+/**
+ * @brief Get all the subintervals, each of them has only one root, using several threads with work stealing
+ *
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param intervals is the vector of disjoint subintervals where the subdivision starts
+ * @param kernel is the range function of the form and the order of convergence
+ * @param n is the level of convergence
+ * @param numThreads is the number of threads
+ * @param counter is the number of range function evaluations
+ * @param derivativesPerInterval is the number of derivatives computed for each subinterval
+ * @return vector<Interval> sorted by the lower bound
+ */
+vector<Interval> ParallelEval(const PolynomialContext &context, const vector<Interval> &intervals, const RangeKernel &kernel, const int n, const int numThreads, double &counter, double &derivativesPerInterval){
+    vector<WorkDeque> deques(numThreads);
+    vector<vector<Interval> > threadZ(numThreads);
+    vector<double> threadCounter(numThreads, 0), threadIntervals(numThreads, 0), threadDerivatives(numThreads, 0);
+    WorkSignal signal(intervals.size());
+    for (int i = 0; i < intervals.size(); i++){
+        deques[0].push(intervals[i]);
+    }
+    vector<thread> threads;
+    for (int i = 0; i < numThreads; i++){
+        threads.push_back(thread(EvalWorker, cref(context), cref(kernel), n, ref(deques), i, ref(signal),
+            ref(threadZ[i]), ref(threadCounter[i]), ref(threadIntervals[i]), ref(threadDerivatives[i])));
+    }
+    for (int i = 0; i < numThreads; i++){
+        threads[i].join();
+    }
+    //Merge the results of all the threads
+    vector<Interval> Z;
+    double numIntervals = 0;
+    double numDerivatives = 0;
+    for (int i = 0; i < numThreads; i++){
+        Z.insert(Z.end(), threadZ[i].begin(), threadZ[i].end());
+        counter += threadCounter[i];
+        numIntervals += threadIntervals[i];
+        numDerivatives += threadDerivatives[i];
+    }
+    //The order in which the threads find the subintervals is not deterministic
+    sort(Z.begin(), Z.end(), [](Interval I, Interval J){ return I.a < J.a; });
+    derivativesPerInterval = (numIntervals > 0) ? numDerivatives / numIntervals : 0;
+    return Z;
+}
+#endif
@@ -6,8 +6,80 @@
 #include <vector>
 #include <iostream>
 #include <limits>
+#include <cstdlib>
+#include <algorithm>
 using namespace std;
 
+/**
+ * @brief Parse the expression in a single pass, writing each term directly in the coefficient of its power
+ * 
+ * @param func is the function to parse, the terms can be in any order, e.g. "- 3x + x^100000 + 1"
+ * @param coeffsFunc is the vector where the coefficients from the highest degree are written
+ * @return true if the expression is parsed, false if a coefficient or an exponent is not valid or a term is not followed by a sign
+ */
+bool parseExpression(const string &func, vector<double> &coeffsFunc){
+    //coeffsByPower[i] is the coefficient of x^i
+    vector<double> coeffsByPower;
+    coeffsFunc.clear();
+    const char *c = func.c_str();
+    while (true){
+        while (*c == ' '){c++;}
+        if (*c == '\0'){break;}
+        //Get the sign of the term
+        double sign = 1;
+        if (*c == '+' || *c == '-'){
+            if (*c == '-'){sign = - 1;}
+            c++;
+            while (*c == ' '){c++;}
+        }
+        //Get the coefficient, it is 1 if it is missing; example x^2
+        double coeffValue = 1;
+        char *next;
+        if (*c != 'x'){
+            coeffValue = strtod(c, &next);
+            if (next == c){
+                printf("Error: cannot parse the expression at \"%s\"\n", c);
+                return false;
+            }
+            c = next;
+        }
+        //Get the exponent, it is 1 if it is missing; example 2x
+        long expValue = 0;
+        if (*c == 'x'){
+            c++;
+            expValue = 1;
+            if (*c == '^'){
+                expValue = strtol(c + 1, &next, 10);
+                //The exponent must be a non-negative integer, e.g. x^-2 and x^2.7 are not polynomial terms
+                if (next == c + 1 || expValue < 0 || (*next != '\0' && *next != ' ' && *next != '+' && *next != '-')){
+                    printf("Error: the exponent must be a non-negative integer at \"%s\"\n", c - 1);
+                    return false;
+                }
+                c = next;
+            }
+        }
+        //A term ends with the sign of the next one, e.g. "2x3" and "3 x^2" are not valid terms
+        const char *end = c;
+        while (*end == ' '){end++;}
+        if (*end != '\0' && *end != '+' && *end != '-'){
+            printf("Error: cannot parse the expression at \"%s\"\n", c);
+            return false;
+        }
+        if (expValue >= (long) coeffsByPower.size()){
+            coeffsByPower.resize(expValue + 1, 0);
+        }
+        coeffsByPower[expValue] += sign * coeffValue;
+    }
+    //Remove the missing leading terms
+    while (coeffsByPower.size() > 1 && coeffsByPower.back() == 0){
+        coeffsByPower.pop_back();
+    }
+    if (coeffsByPower.empty()){coeffsByPower.push_back(0);}
+    reverse(coeffsByPower.begin(), coeffsByPower.end());
+    coeffsFunc.swap(coeffsByPower);
+    return true;
+}
+
 /**
  * @brief Parse the expression
  * 
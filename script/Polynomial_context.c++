@@ -0,0 +1,73 @@
+//Copyright(C) 2022-2023 by Brian Bronz
+#ifndef POLYNOMIAL_CONTEXT_H
+#define POLYNOMIAL_CONTEXT_H
+#include <string>
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <limits>
+#include "main.h"
+using namespace std;
+
+/**
+ * @brief Constructor for the class PolynomialContext
+ *
+ * @param coeffsFunc is the vector of coefficients of the function f(x)
+ * @param maxOrder is the highest derivative needed by the range functions and Newton's method
+ */
+PolynomialContext::PolynomialContext(const vector<double> coeffsFunc, const int maxOrder){
+    this->coeffsFunc = coeffsFunc;
+    this->degree = coeffsFunc.size() - 1;
+    //f^{(0)}(x), ..., f^{(maxOrder)}(x); derivatives above the degree are the zero polynomial
+    const int numDerivatives = min(maxOrder, degree);
+    derivatives.push_back(coeffsFunc);
+    for (int i = 1; i <= numDerivatives; i++){
+        derivatives.push_back(kDerivative(derivatives[i - 1], 1));
+    }
+    //0!, 1!, ..., (maxOrder + 1)!
+    factorials.push_back(1);
+    for (int i = 1; i <= maxOrder + 1; i++){
+        factorials.push_back(factorials[i - 1] * i);
+    }
+};
+
+/**
+ * @brief Get the coefficients of the i-derivative f^{(i)}(x)
+ *
+ * @param i is the order of the derivative
+ * @return const vector<double>&
+ */
+const vector<double> &PolynomialContext::getDerivative(const int i) const{
+    if (i >= derivatives.size()){
+        return zeroPolynomial;
+    }
+    return derivatives[i];
+};
+
+/**
+ * @brief Get the factorial i!
+ *
+ * @param i is a number
+ * @return double
+ */
+double PolynomialContext::getFactorial(const int i) const{
+    return factorials[i];
+};
+
+/**
+ * @brief Get the highest derivative needed to evaluate the range functions and refine the roots
+ *
+ * @param formInterpolation is the form of the interpolation (Taylor or Lagrange)
+ * @param k is the order of the convergence
+ * @param n is the level of the convergence
+ * @return int
+ */
+int requiredDerivativeOrder(const string formInterpolation, const int k, const int n){
+    if (formInterpolation == "Lagrange"){
+        //h_j(I) uses f^{(3j)}(x) and the remainder uses f^{(3n)}(x)
+        return max(1, 3 * n);
+    }
+    //g_k1 of f'(x) uses f^{(k)}(x), S_kn uses up to f^{(n)}(x) and its tail f^{(n+1)}(x)
+    return max(k + 1, n + 1);
+}
+#endif
@@ -0,0 +1,164 @@
+//Copyright(C) 2022-2023 by Brian Bronz
+#ifndef POLYNOMIAL_FAMILY_H
+#define POLYNOMIAL_FAMILY_H
+#include <string>
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <iomanip>
+using namespace std;
+
+/**
+ * @brief Write the absolute value of a coefficient with all its digits, parsed back to the same double
+ *
+ * @param coefficient is the coefficient
+ * @return string
+ */
+string coefficientString(const double coefficient){
+    ostringstream stream;
+    stream << setprecision(17) << abs(coefficient);
+    return stream.str();
+}
+
+/**
+ * @brief Write the expression of a polynomial function in the format of the input file
+ *
+ * @param coeffsFunc is the coefficients of the function f(x), from the highest degree
+ * @return string like "- 9x^3 + 2x - 4"
+ */
+string polynomialExpression(const vector<double> coeffsFunc){
+    string function = "";
+    const int degree = coeffsFunc.size() - 1;
+    for (int i = degree; i >= 0; i--){
+        const double coefficient = coeffsFunc[degree - i];
+        //Skip the missing terms, except the leading one
+        if (coefficient == 0 && i != degree){continue;}
+        const string sign = (coefficient < 0) ? " - " : " + ";
+        if (i == 0){
+            function += sign + coefficientString(coefficient);
+        } else if (i == 1){
+            function += sign + coefficientString(coefficient) + "x";
+        } else {
+            function += sign + coefficientString(coefficient) + "x^" + to_string(i);
+        }
+    }
+    return function.substr(1);
+}
+
+/**
+ * @brief Generate a dense polynomial function with integer coefficients between 1 and 9 and random signs
+ *
+ * @param degree is the degree of the function
+ * @param gen is the random generator
+ * @return vector<double>
+ */
+vector<double> densePolynomial(const int degree, mt19937 &gen){
+    uniform_real_distribution<> dis(1, 10);
+    vector<double> coeffsFunc;
+    for (int i = 0; i <= degree; i++){
+        //Set the precision to 0 decimal places
+        double coefficient = (int) dis(gen);
+        coeffsFunc.push_back((gen() % 2 == 0) ? - coefficient : coefficient);
+    }
+    return coeffsFunc;
+}
+
+/**
+ * @brief Generate a sparse polynomial function: x^degree, a constant and a few random terms in between
+ *
+ * @param degree is the degree of the function
+ * @param numTerms is the number of terms between the leading one and the constant
+ * @param gen is the random generator
+ * @return vector<double>
+ */
+vector<double> sparsePolynomial(const int degree, const int numTerms, mt19937 &gen){
+    vector<double> coeffsFunc(degree + 1, 0);
+    coeffsFunc[0] = 1;
+    coeffsFunc[degree] = - 1;
+    for (int i = 0; i < numTerms && degree > 1; i++){
+        const int power = 1 + gen() % (degree - 1);
+        coeffsFunc[degree - power] = (gen() % 2 == 0) ? - (1.0 + gen() % 9) : (1.0 + gen() % 9);
+    }
+    return coeffsFunc;
+}
+
+//Largest number of real roots in the cluster, more close roots make the coefficients too ill-conditioned
+const int CLUSTER_SIZE = 8;
+
+/**
+ * @brief Get the number of real roots of the clustered polynomial function of a degree
+ *
+ * @param degree is the degree of the function
+ * @return int, the rest of the degree is even
+ */
+int clusteredRootCount(const int degree){
+    const int numRoots = min(degree, CLUSTER_SIZE);
+    return ((degree - numRoots) % 2 == 0) ? numRoots : numRoots - 1;
+}
+
+/**
+ * @brief Generate a polynomial function with a cluster of close real roots around the center,
+ * (x - r_1)...(x - r_m)(x^q + 1) where the m roots are gap apart and q is even, so x^q + 1 has no real roots
+ *
+ * @param degree is the degree of the function
+ * @param center is the center of the cluster
+ * @param gap is the distance between two consecutive roots
+ * @return vector<double>
+ */
+vector<double> clusteredPolynomial(const int degree, const double center, const double gap){
+    const int numRoots = clusteredRootCount(degree);
+    vector<double> coeffsFunc = {1};
+    for (int i = 0; i < numRoots; i++){
+        const double root = center + (i - (numRoots - 1) / 2.0) * gap;
+        //Multiply by (x - root)
+        coeffsFunc.push_back(0);
+        for (int j = coeffsFunc.size() - 1; j > 0; j--){
+            coeffsFunc[j] = coeffsFunc[j] - root * coeffsFunc[j - 1];
+        }
+    }
+    //Multiply by (x^q + 1), q is even
+    const int q = degree - numRoots;
+    if (q == 0){return coeffsFunc;}
+    vector<double> product(degree + 1, 0);
+    for (int j = 0; j < coeffsFunc.size(); j++){
+        product[j] += coeffsFunc[j];
+        product[j + q] += coeffsFunc[j];
+    }
+    return product;
+}
+
+/**
+ * @brief Perturb every coefficient of a polynomial function by a random relative error
+ *
+ * @param coeffsFunc is the coefficients of the function f(x)
+ * @param relative is the largest relative error
+ * @param gen is the random generator
+ * @return vector<double>
+ */
+vector<double> perturbedPolynomial(vector<double> coeffsFunc, const double relative, mt19937 &gen){
+    uniform_real_distribution<> dis(- relative, relative);
+    for (int i = 0; i < coeffsFunc.size(); i++){
+        coeffsFunc[i] *= 1 + dis(gen);
+    }
+    return coeffsFunc;
+}
+
+/**
+ * @brief Generate a polynomial function of a family
+ *
+ * @param family is the family: dense (as createInput), sparse or clustered
+ * @param degree is the degree of the function
+ * @param gen is the random generator
+ * @return vector<double>
+ */
+vector<double> generatePolynomial(const string family, const int degree, mt19937 &gen){
+    if (family == "sparse"){
+        return sparsePolynomial(degree, 8, gen);
+    } else if (family == "clustered"){
+        return clusteredPolynomial(degree, 0.25, 0.05);
+    }
+    return densePolynomial(degree, gen);
+}
+#endif
@@ -0,0 +1,62 @@
+//Copyright(C) 2022-2023 by Brian Bronz
+#ifndef PROFILE_H
+#define PROFILE_H
+#include <string>
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <limits>
+#include <chrono>
+#include "main.h"
+using namespace std;
+
+//Timers and counters of the current thread
+thread_local PhaseProfile profile;
+
+/**
+ * @brief Constructor for the class PhaseProfile
+ */
+PhaseProfile::PhaseProfile(){
+    reset();
+};
+
+/**
+ * @brief Set all the timers and counters to zero
+ */
+void PhaseProfile::reset(){
+    taylorFTime = 0;
+    taylorDfTime = 0;
+    lagrangeFTime = 0;
+    lagrangeDfTime = 0;
+    intervalsPushed = 0;
+    maxQueueDepth = 0;
+    numRoots = 0;
+    newtonIterations = 0;
+};
+
+/**
+ * @brief Add the time taken by the range function f(x), respectively f'(x)
+ *
+ * @param taylor is true for the Taylor form, false for the Lagrange form
+ * @param dF is a boolean that indicates if the derivative function is used
+ * @param start is the time when the range function started
+ */
+void PhaseProfile::addRangeFunction(const bool taylor, const bool dF, const chrono::steady_clock::time_point start){
+    const double seconds = elapsedSeconds(start);
+    if (taylor){
+        (dF) ? taylorDfTime += seconds : taylorFTime += seconds;
+    } else {
+        (dF) ? lagrangeDfTime += seconds : lagrangeFTime += seconds;
+    }
+};
+
+/**
+ * @brief Get the wall-clock time elapsed from a starting time
+ *
+ * @param start is the starting time
+ * @return double seconds
+ */
+double elapsedSeconds(const chrono::steady_clock::time_point start){
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+#endif
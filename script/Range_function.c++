@@ -7,40 +7,95 @@
 #include <iostream>
 #include <limits>
 #include "main.h"
+#include "Taylor_form.c++"
+#include "Lagrange_form.c++"
 using namespace std;
 
 /**
- * @brief Construct a new RangeFunc::RangeFunc object
- * 
- * @param a is the lower bound of the interval
- * @param b is the upper bound of the interval
+ * @brief Constructor for the class FrontierValues
+ *
+ * @param values is the vector of the values of each derivative in all the points of the frontier
+ * @param p is the index of the point
  */
-RangeFunc::RangeFunc(const double a, const double b){
-            this->a = a;
-            this->b = b;
+FrontierValues::FrontierValues(const vector<vector<double> > &values, const int p){
+    this->values = &values;
+    this->p = p;
 };
 
 /**
- * @brief Get the derivative function
- * 
- * @param I is the interval
- * @param n is the level of the convergence
- * @param k is the order of the convergence
- * @return vector<double> 
+ * @brief Get the value of the i-th derivative in the point, the derivatives not computed are above the degree
+ *
+ * @param i is the index of the derivative
+ * @return double
  */
-Interval RangeFunc::getDf(Interval I, const int n, const int k){
-    return Interval(0, 0);
+double FrontierValues::operator()(const int i) const{
+    return (i < values->size()) ? (*values)[i][p] : 0;
+};
+
+/**
+ * @brief Constructor for the class PointValues
+ *
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param step is the distance between the orders of two consecutive derivatives, 1 for Taylor and 3 for Lagrange
+ * @param x is the point
+ */
+PointValues::PointValues(const PolynomialContext &context, const int step, const double x){
+    this->context = &context;
+    this->step = step;
+    this->x = x;
 };
 
 /**
- * @brief Get the function
- * 
- * @param I is the interval
- * @param n is the level of the convergence
- * @param k is the order of the convergence
- * @return vector<double> 
+ * @brief Get the value of the (step * i)-th derivative in the point
+ *
+ * @param i is the index of the derivative
+ * @return double
  */
-Interval RangeFunc::getF(Interval I, const int n, const int k){
+double PointValues::operator()(const int i) const{
+    return functionValue(context->getDerivative(step * i), x);
+};
+
+/**
+ * @brief Range function of an unknown form, all the subintervals are discarded
+ */
+void zeroFrontier(const vector<Interval> &frontier, const PolynomialContext &/*context*/, const int /*n*/, const bool /*dF*/, vector<Interval> &ranges){
+    ranges.assign(frontier.size(), Interval(0, 0));
+}
+
+/**
+ * @brief Range function of an unknown form, the subinterval is discarded
+ */
+Interval zeroPoint(Interval /*I*/, const PolynomialContext &/*context*/, const int /*n*/, const bool /*dF*/){
     return Interval(0, 0);
+}
+
+/**
+ * @brief Constructor for the class RangeKernel, selecting the range functions once for each job
+ *
+ * @param formInterpolation is the form of the interpolation (Taylor or Lagrange)
+ * @param k is the order of the convergence, between 1 and 4 for the Taylor form and always 3 for the Lagrange form
+ */
+RangeKernel::RangeKernel(const string formInterpolation, const int k){
+    taylor = (formInterpolation == "Taylor");
+    frontierRange = zeroFrontier;
+    pointRange = zeroPoint;
+    if (formInterpolation == "Lagrange"){
+        frontierRange = lagrangeFrontier;
+        pointRange = lagrangePoint;
+    } else if (taylor && k == 1){
+        frontierRange = taylorFrontier<1>;
+        pointRange = taylorPoint<1>;
+    } else if (taylor && k == 2){
+        frontierRange = taylorFrontier<2>;
+        pointRange = taylorPoint<2>;
+    } else if (taylor && k == 3){
+        frontierRange = taylorFrontier<3>;
+        pointRange = taylorPoint<3>;
+    } else if (taylor && k == 4){
+        frontierRange = taylorFrontier<4>;
+        pointRange = taylorPoint<4>;
+    } else if (taylor){
+        printf("Error: the order of convergence of the Taylor form must be between 1 and 4\n");
+    }
 };
-#endif 
\ No newline at end of file
+#endif
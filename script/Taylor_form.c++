@@ -7,150 +7,162 @@
 #include <iostream>
 #include <limits>
 #include "Evaluate.c++"
-#include "Range_function.c++"
 #include "Interval.c++"
 #include "simpleOperations.c++"
 using namespace std;
 
-/**
- * @brief Constructor for the class TaylorInterpolation
- * 
- * @param coeffsFunc is the coefficients of the function f(x)
- * @param approximateInterval is the interval of the remainder
- * @param a is the lower bound of the interval
- * @param b is the upper bound of the interval
- */
-TaylorInterpolation::TaylorInterpolation(const vector<double> coeffsFunc, Interval approximateInterval, const double a, const double b) : RangeFunc(a, b){
-    this->coeffsFunc = coeffsFunc;
-    this->approximateInterval = approximateInterval;
-};
+//0!, 1!, ..., 4! used by the exact part of the Taylor form, k <= 4
+constexpr double TAYLOR_FACTORIALS[5] = {1, 1, 2, 6, 24};
 
 /**
- * @brief Compute the interval of the exact part of the function f(x) in the interval I
- * 
- * @param coeffsFunct is the coefficients of the Taylor polynomial
- * @param k is the order of the convergence
+ * @brief Compute the interval of the exact part g_{k-1}(x) of the function f(x), respectively f'(x), in the interval I
+ *
+ * @tparam K is the order of the convergence
+ * @tparam Df is true if the derivative of the function is needed
+ * @param values gives f^{(i)}(m) in the midpoint of the interval
  * @param I is the interval
- * @param Df is true if the derivative of the function is needed
+ * @param degree is the degree of the function f(x)
  * @return Interval
  */
-Interval TaylorInterpolation::g_k1(vector<double> coeffsFunct, const int k, Interval I, const bool Df){
-    //Set the maximum degree of the function
-    int sizeCoeffs = coeffsFunct.size();
-    //Calculate the k-derivate
-    const double midpoint = I.getMidpoint();
-    vector<double> temp(k + 1, 0);
-    int i = 0;
-    int factValue = 1;
-    while (i <= k && sizeCoeffs > 0){
-        //Calculate the new coeffsFunc of the function 
-        double functionVal = functionValue(coeffsFunct, midpoint);
-        temp[i] = functionVal;
-        for (int j = 0; j < sizeCoeffs; j++){
-                coeffsFunct[j] = coeffsFunct[j] * (sizeCoeffs - j - 1);
-        }
-        //Calculate f^{(i)}(m)/i!
-        if (Df){ // for the derivative => g_k1^{1}
-            factValue = factValue * (i + 1);
-            temp[i] = (i + 1) * temp[i] / factValue;
-        } else { // for the original function => g_k1^{0}
-            if (i != 0){factValue = factValue * i;}
-            temp[i] = temp[i] / factValue;
+template <int K, bool Df, class Values>
+Interval taylorExact(const Values &values, Interval I, const int degree){
+    //The Taylor polynomial of f'(x) starts from f^{(1)}(x)
+    const int firstDerivative = (Df) ? 1 : 0;
+    //Coefficients f^{(i)}(m)/i!, from the lowest degree
+    double temp[K];
+    for (int i = 0; i < K; i++){
+        temp[i] = 0;
+        if (i + firstDerivative <= degree){
+            const double functionVal = values(i + firstDerivative);
+            if (Df){ // for the derivative => g_k1^{1}
+                temp[i] = (i + 1) * functionVal / TAYLOR_FACTORIALS[i + 1];
+            } else { // for the original function => g_k1^{0}
+                temp[i] = functionVal / TAYLOR_FACTORIALS[i];
+            }
         }
-        //Remove the last coefficient and decrease the degree of the function
-        coeffsFunct.pop_back();
-        sizeCoeffs--;
-        i++;
     }
-    coeffsFunct = temp;
-    reverse(coeffsFunct.begin(), coeffsFunct.end());
-    return functionValue(coeffsFunct, I);
+    //Horner's method in the interval I - m, from the highest degree
+    Interval res = Interval(temp[K - 1], temp[K - 1]);
+    Interval I_m = Substraction(I, I.getMidpoint());
+    for (int i = K - 2; i >= 0; i--){
+        res = Sum(Multiplication(res, I_m), temp[i]);
+    }
+    if (res.getA() == res.getB()){
+        res = Interval( - abs(res.getA()), abs(res.getB()));
+    }
+    return res;
 }
+
 /**
- * @brief Compute the approximation of the function f(x) in the interval I
- * 
- * @param k is the order of the convergence
- * @param coeffsFunct is the coefficients of the Taylor polynomial
- * @param r is the radius of the interval
- * @param n is the level of the Taylor polynomial
+ * @brief Compute the remainder S_{k,n}(I) of the function f(x), respectively S_{k+1,n}(I) of f'(x)
+ *
+ * The terms of the order k to n are bounded with f^{(i)}(m), the rest of the series with the range of f^{(n+1)}(I)
+ * as in the Lagrange form of the remainder, so that the range function contains the range of f(x) for every level
+ *
+ * @tparam K is the order of the convergence
+ * @tparam Df is true if the derivative of the function is needed
+ * @param values gives f^{(i)}(m) in the midpoint of the interval
+ * @param tail is the interval of f^{(n+1)}(I), used if n + 1 is not above the degree
  * @param I is the interval
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param n is the level of the Taylor polynomial, at least k - 1, respectively k
  * @return Interval
  */
-Interval TaylorInterpolation::S_kn(const int k, const int n, Interval I, vector<double> coeffsFunct, const bool Df){
-    int sizeCoeffs = coeffsFunct.size();
-    //Calculate the k-derivate
-    vector<double> temp;
-    //|f^{i}(m)|
+template <int K, bool Df, class Values>
+Interval taylorRemainder(const Values &values, Interval tail, Interval I, const PolynomialContext &context, const int n){
+    const int first = (Df) ? K + 1 : K;
     const double r = I.getRadius(); //The radius of the interval
-    const double midpoint = I.getMidpoint();
-    double r_i_k = 1;
-    int i = k;
-    int factVal = factorial(k);
-    while (i <= n && sizeCoeffs != 0){
-        //Calculate the new coeffsFunc of the function 
-        double functionVal = functionValue(coeffsFunct, midpoint);
-        temp.push_back(abs(functionVal));
-        for (int j = 0; j < sizeCoeffs; j++){
-                coeffsFunct[j] = coeffsFunct[j] * (sizeCoeffs- j - 1);
-        }
-        //Calculate f^{(i)}(m)/i!
-        if (Df){
-            factVal = factVal * (i + 1);
-            temp[i - k] = (i + 1) * temp[i - k] / factVal;
-        } else {
-            if (i != k){factVal = factVal * i;}
-            temp[i - k] = temp[i - k] / factVal;
-            
-        }
-        //Remove the last coefficient and decrease the degree of the function
-        coeffsFunct.pop_back();
-        sizeCoeffs--;
-        i++;
+    //r^i for f(x), respectively r^{i - 1} for f'(x): both the remainders start from (x - m)^k
+    double r_i = 1;
+    for (int i = 0; i < K; i++){
+        r_i = r_i * r;
     }
-    coeffsFunct = temp;
-    //r^k
-    double rk = r;
-    //c_i * r^i
-    double cr = r_i_k * coeffsFunct[0];
-    for (int i = 1; i < coeffsFunct.size(); i++){
-        r_i_k = r_i_k * r;
-        cr = cr + coeffsFunct[i] * r_i_k; 
-        if (i < k){rk = rk * r;}
+    //c_i * r^i, with c_i = |f^{(i)}(m)| / i!, respectively c_i = |f^{(i)}(m)| / (i - 1)!
+    double cr = 0;
+    for (int i = first; i <= n && i <= context.degree; i++){
+        const double functionVal = values(i);
+        const double c = (Df) ? abs(functionVal) / context.getFactorial(i - 1) : abs(functionVal) / context.getFactorial(i);
+        cr = cr + c * r_i;
+        r_i = r_i * r;
     }
-
-    Interval interval_rk = MultiConstant(Interval( - 1, 1), rk);
-    return MultiConstant(interval_rk, cr);
-};
+    //f^{(n+1)}(xi) / (n + 1)! (x - m)^{n+1}, respectively f^{(n+1)}(xi) / n! (x - m)^n
+    if (n + 1 <= context.degree){
+        const double magnitude = max(abs(tail.getA()), abs(tail.getB()));
+        //An overflow in the range of f^{(n+1)}(I) leaves the remainder unbounded
+        cr = (isfinite(magnitude)) ? cr + magnitude * r_i / context.getFactorial((Df) ? n : n + 1) : numeric_limits<double>::infinity();
+    }
+    return Interval( - cr, cr);
+}
 
 /**
- * @brief Get the range function of the function f(x)
- * 
+ * @brief Get the range function of the function f(x), respectively f'(x), in the Taylor form
+ *
+ * @tparam K is the order of the convergence
+ * @tparam Df is true if the derivative of the function is needed
+ * @param values gives f^{(i)}(m) in the midpoint of the interval
  * @param I is the interval
- * @param n is the level of convergence
- * @param k is the order of the convergence
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param n is the level of the convergence
  * @return Interval
  */
-Interval TaylorInterpolation::getF(Interval I, const int n, const int k){
-    const Interval exactInterval = g_k1(coeffsFunc, k - 1, I, false);
-    coeffsFunc = kDerivative(coeffsFunc, k);
-    approximateInterval = S_kn(k, n, I, coeffsFunc, false);
-    return Sum(exactInterval, approximateInterval);
-};
+template <int K, bool Df, class Values>
+Interval taylorRange(const Values &values, Interval I, const PolynomialContext &context, const int n){
+    static_assert(K >= 1 && K <= 4, "The order of the Taylor form must be between 1 and 4");
+    //The exact part ends with the term k - 1, respectively k of f(x): the remainder starts after it
+    const int level = max(n, (Df) ? K : K - 1);
+    const Interval exactInterval = taylorExact<K, Df>(values, I, context.degree);
+    const Interval tail = (level + 1 <= context.degree) ? functionRange(context.getDerivative(level + 1), I) : Interval(0, 0);
+    return Sum(exactInterval, taylorRemainder<K, Df>(values, tail, I, context, level));
+}
 
 /**
- * @brief Get the range function of the first derivative f^{'}(x)
- * 
+ * @brief Compute the range function f(x), respectively f'(x), in all the subintervals of a frontier with the Taylor form
+ *
+ * @tparam K is the order of the convergence
+ * @param frontier is the vector of subintervals
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param n is the level of the convergence
+ * @param dF is a boolean that indicates if the derivative function is used
+ * @param ranges is the vector where the range functions are written
+ */
+template <int K>
+void taylorFrontier(const vector<Interval> &frontier, const PolynomialContext &context, const int n, const bool dF, vector<Interval> &ranges){
+    const int numIntervals = frontier.size();
+    vector<double> midpoints(numIntervals);
+    for (int p = 0; p < numIntervals; p++){
+        midpoints[p] = (frontier[p].a + frontier[p].b) / 2;
+    }
+    //f^{(i)}(m) for all the subintervals, the derivatives above the degree are zero
+    const int numOrders = min(max(n, K + 1), context.degree) + 1;
+    vector<vector<double> > values(numOrders);
+    for (int i = 0; i < numOrders; i++){
+        functionValues(context.getDerivative(i), midpoints, values[i]);
+    }
+    ranges.resize(numIntervals, Interval(0, 0));
+    if (dF){
+        for (int p = 0; p < numIntervals; p++){
+            ranges[p] = taylorRange<K, true>(FrontierValues(values, p), frontier[p], context, n);
+        }
+    } else {
+        for (int p = 0; p < numIntervals; p++){
+            ranges[p] = taylorRange<K, false>(FrontierValues(values, p), frontier[p], context, n);
+        }
+    }
+}
+
+/**
+ * @brief Compute the range function f(x), respectively f'(x), in a single interval with the Taylor form
+ *
+ * @tparam K is the order of the convergence
  * @param I is the interval
- * @param n is the level of convergence
- * @param k is the order of the convergence
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param n is the level of the convergence
+ * @param dF is a boolean that indicates if the derivative function is used
  * @return Interval
  */
-Interval TaylorInterpolation::getDf(Interval I, const int n, const int k){
-    const vector<double> initialCoeffsFunc = coeffsFunc;
-    coeffsFunc = kDerivative(coeffsFunc, 1);
-    const Interval exactInterval = g_k1(coeffsFunc, k - 1, I, true);
-    coeffsFunc = kDerivative(initialCoeffsFunc, k + 1);
-    approximateInterval = S_kn(k + 1, n, I, coeffsFunc, true);
-    return Sum(exactInterval, approximateInterval);
-};
+template <int K>
+Interval taylorPoint(Interval I, const PolynomialContext &context, const int n, const bool dF){
+    const PointValues values(context, 1, I.getMidpoint());
+    return (dF) ? taylorRange<K, true>(values, I, context, n) : taylorRange<K, false>(values, I, context, n);
+}
 #endif
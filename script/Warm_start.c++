@@ -0,0 +1,246 @@
+//Copyright(C) 2022-2023 by Brian Bronz
+#ifndef WARM_START_H
+#define WARM_START_H
+#include <string>
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <algorithm>
+#include <chrono>
+#include "main.h"
+using namespace std;
+
+/**
+ * @brief Bound |f(x) - g(x)| in each subinterval, where g(x) is the previous polynomial function
+ *
+ * The difference is bounded by the sum of |f_i - g_i| |x|^i in the point of the subinterval farthest from 0
+ *
+ * @param coeffsFunc is the coefficients of the function f(x)
+ * @param previousCoeffs is the coefficients of the function g(x), it can have another degree
+ * @param intervals is the vector of subintervals
+ * @param bounds is the vector where the bounds are written
+ */
+void perturbationBounds(const vector<double> &coeffsFunc, const vector<double> &previousCoeffs, const vector<Interval> &intervals, vector<double> &bounds){
+    //|f_i - g_i| from the highest degree, the coefficients are aligned on the constant term
+    const int size = max(coeffsFunc.size(), previousCoeffs.size());
+    vector<double> difference(size);
+    for (int i = 0; i < size; i++){
+        const int f_i = i - (size - (int) coeffsFunc.size());
+        const int g_i = i - (size - (int) previousCoeffs.size());
+        difference[i] = abs(((f_i >= 0) ? coeffsFunc[f_i] : 0) - ((g_i >= 0) ? previousCoeffs[g_i] : 0));
+    }
+    vector<double> points(intervals.size());
+    for (int p = 0; p < intervals.size(); p++){
+        points[p] = max(abs(intervals[p].a), abs(intervals[p].b));
+    }
+    functionValues(difference, points, bounds);
+    //Horner's method on positive numbers: at most 2 size roundings
+    const double rounding = 1 + (2 * size + 2) * numeric_limits<double>::epsilon();
+    for (int p = 0; p < intervals.size(); p++){
+        bounds[p] *= rounding;
+    }
+}
+
+/**
+ * @brief Get all the subintervals with only one root, reusing the solution of a close polynomial function
+ *
+ * The isolating subintervals of the previous solution are kept if f'(x) does not vanish in them, by a non-degenerate range
+ * or by the sign variations, and f(a) f(b) < 0. Its subintervals without roots are kept if the bound of |f(x)| there is
+ * above the change of the function. The initial bound is covered by these subintervals and the others,
+ * which are subdivided as in the Eval algorithm: no root is missed, the roots that moved and the new ones are found there
+ *
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param initialBound is the interval containing all real roots
+ * @param formInterpolation is a string for Taylor or Lagrange interpolation
+ * @param k is the order of convergence
+ * @param n is the level of convergence
+ * @param previous is the solution of the previous polynomial function, empty to start from scratch
+ * @param hintIdx is the vector where the index in previous.Z of each subinterval is written, -1 if it comes from the subdivision
+ * @param solution is the solution where the subintervals without roots are added
+ * @param counter is the number of range function evaluations
+ * @param derivativesPerInterval is the number of derivatives computed for each subinterval of the local subdivision
+ * @return vector<Interval> sorted by the lower bound
+ */
+vector<Interval> WarmEval(const PolynomialContext &context, Interval initialBound, const string formInterpolation, const int k, const int n, const Solution &previous, vector<int> &hintIdx, Solution &solution, double &counter, double &derivativesPerInterval){
+    counter = 0;
+    const RangeKernel kernel(formInterpolation, k);
+    //Subintervals of the previous solution sorted by the lower bound: the isolating ones, then the ones without roots
+    vector<Interval> pieces = previous.Z;
+    pieces.insert(pieces.end(), previous.freeIntervals.begin(), previous.freeIntervals.end());
+    vector<int> order(pieces.size());
+    for (int i = 0; i < pieces.size(); i++){
+        order[i] = i;
+    }
+    sort(order.begin(), order.end(), [&pieces](int i, int j){ return pieces[i].a < pieces[j].a; });
+    //Cut them at the bounds of the initial subintervals, the parts not covered are subdivided
+    const vector<Interval> intervals = initialIntervals(context.coeffsFunc, initialBound);
+    vector<Interval> frontier, hints, freeIntervals;
+    vector<int> hintPiece;
+    vector<double> margins;
+    for (int i = 0; i < intervals.size(); i++){
+        double left = intervals[i].a;
+        for (int p = 0; p < order.size(); p++){
+            const Interval I = pieces[order[p]];
+            const double a = max(I.a, left);
+            const double b = min(I.b, intervals[i].b);
+            if (a >= b){continue;}
+            if (a > left){frontier.push_back(Interval(left, a));}
+            if (order[p] < previous.Z.size()){
+                hints.push_back(Interval(a, b));
+                hintPiece.push_back(order[p]);
+            } else {
+                freeIntervals.push_back(Interval(a, b));
+                margins.push_back(previous.margins[order[p] - previous.Z.size()]);
+            }
+            left = b;
+        }
+        if (left < intervals[i].b){frontier.push_back(Interval(left, intervals[i].b));}
+    }
+    //The subintervals without roots stay so if |f(x) - g(x)| is below the bound of |g(x)|
+    vector<double> bounds;
+    perturbationBounds(context.coeffsFunc, previous.coeffsFunc, freeIntervals, bounds);
+    for (int p = 0; p < freeIntervals.size(); p++){
+        if (bounds[p] < margins[p]){
+            solution.freeIntervals.push_back(freeIntervals[p]);
+            solution.margins.push_back(margins[p] - bounds[p]);
+        } else {
+            frontier.push_back(freeIntervals[p]);
+        }
+    }
+    //f(x) must be monotone in the isolating subintervals
+    vector<Interval> dFuncIntervals;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    kernel.frontierRange(hints, context, n, true, dFuncIntervals);
+    profile.addRangeFunction(kernel.taylor, true, start);
+    counter += hints.size();
+    vector<bool> monotone(hints.size(), true);
+    vector<Interval> undecided;
+    vector<int> undecidedIdx;
+    for (int p = 0; p < hints.size(); p++){
+        //A range reduced to [0, 0] certifies nothing, e.g. the one of an unknown form
+        const bool degenerate = dFuncIntervals[p].getA() == 0 && dFuncIntervals[p].getB() == 0;
+        if (degenerate || (dFuncIntervals[p].getA() < 0 && dFuncIntervals[p].getB() > 0)){
+            monotone[p] = false;
+            undecided.push_back(hints[p]);
+            undecidedIdx.push_back(p);
+        }
+    }
+    if (signPruning && !undecided.empty()){
+        vector<int> results;
+        descartesTest(context, undecided, results);
+        for (int p = 0; p < undecided.size(); p++){
+            if (results[p] == 1){monotone[undecidedIdx[p]] = true;}
+        }
+    }
+    //The root must be bracketed, a root in an endpoint is left to the subdivision
+    vector<double> lower(hints.size()), upper(hints.size()), f_a, f_b;
+    for (int p = 0; p < hints.size(); p++){
+        lower[p] = hints[p].a;
+        upper[p] = hints[p].b;
+    }
+    functionValues(context.coeffsFunc, lower, f_a);
+    functionValues(context.coeffsFunc, upper, f_b);
+    vector<Interval> Z;
+    hintIdx.clear();
+    for (int p = 0; p < hints.size(); p++){
+        if (monotone[p] && f_a[p] * f_b[p] < 0){
+            Z.push_back(hints[p]);
+            hintIdx.push_back(hintPiece[p]);
+        } else {
+            frontier.push_back(hints[p]);
+        }
+    }
+    //Local subdivision where the previous solution does not hold
+    const vector<Interval> newZ = EvalFrontier(context, frontier, kernel, n, 1, counter, derivativesPerInterval, solution.freeIntervals, solution.margins);
+    for (int p = 0; p < newZ.size(); p++){
+        Z.push_back(newZ[p]);
+        hintIdx.push_back(- 1);
+    }
+    //Sort the subintervals of both kinds
+    order.resize(Z.size());
+    for (int i = 0; i < Z.size(); i++){
+        order[i] = i;
+    }
+    sort(order.begin(), order.end(), [&Z](int i, int j){ return Z[i].a < Z[j].a; });
+    vector<Interval> sortedZ;
+    vector<int> sortedIdx;
+    for (int i = 0; i < order.size(); i++){
+        sortedZ.push_back(Z[order[i]]);
+        sortedIdx.push_back(hintIdx[order[i]]);
+    }
+    hintIdx.swap(sortedIdx);
+    return sortedZ;
+}
+
+/**
+ * @brief Find all the real roots of a polynomial function close to an already solved one
+ *
+ * @param context is the polynomial function f(x) with its derivatives
+ * @param initialBound is the interval containing all real roots
+ * @param formInterpolation is a string for Taylor or Lagrange interpolation
+ * @param k is the order of convergence
+ * @param n is the level of convergence
+ * @param previous is the solution of the previous polynomial function, empty to start from scratch
+ * @param counter is the number of range function evaluations
+ * @param derivativesPerInterval is the number of derivatives computed for each subinterval of the local subdivision
+ * @return Solution
+ */
+Solution WarmSolve(const PolynomialContext &context, Interval initialBound, const string formInterpolation, const int k, const int n, const Solution &previous, double &counter, double &derivativesPerInterval){
+    Solution solution;
+    solution.coeffsFunc = context.coeffsFunc;
+    vector<int> hintIdx;
+    solution.Z = WarmEval(context, initialBound, formInterpolation, k, n, previous, hintIdx, solution, counter, derivativesPerInterval);
+    //Newton's method starts from the previous root, or from the midpoint for the new subintervals
+    vector<double> start(solution.Z.size());
+    for (int i = 0; i < solution.Z.size(); i++){
+        start[i] = (hintIdx[i] >= 0) ? previous.roots[hintIdx[i]].value : solution.Z[i].getMidpoint();
+    }
+    const int maxIterations = 100;
+    const double tolerance = 1e-10;
+    solution.roots = refineRoots(context, solution.Z, start, maxIterations, tolerance);
+    return solution;
+}
+
+/**
+ * @brief Find all the real roots of a sequence of close polynomial functions, each of them warm-started from the previous one
+ *
+ * @param coeffsFunc is the vector of the coefficients of each polynomial function, in the order of the sequence,
+ * empty if the polynomial function cannot be parsed
+ * @param expressions is the vector of the expression of each polynomial function
+ * @param formInterpolation is a string for Taylor or Lagrange interpolation
+ * @param k is the order of convergence
+ * @param n is the level of convergence
+ * @param file is the file where the results are written
+ * @param timeFile is the file where the time of each polynomial function is written
+ * @param iterationFile is the file where the number of range function evaluations is written
+ */
+void SolveSequence(const vector<vector<double> > &coeffsFunc, const vector<string> &expressions, const string formInterpolation, const int k, const int n, ostream &file, ostream &timeFile, ostream &iterationFile){
+    Solution solution;
+    for (int i = 0; i < coeffsFunc.size(); i++){
+        file << "expression: " << expressions[i] << endl;
+        //The job fails, the next polynomial function starts from the last solution
+        if (coeffsFunc[i].empty()){
+            file << "The expression cannot be parsed" << endl;
+            file << "The order of convergence is: " << k << " " << "the level is: " << n << endl;
+            file << endl;
+            continue;
+        }
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        const PolynomialContext context(coeffsFunc[i], requiredDerivativeOrder(formInterpolation, k, n));
+        const Interval initialBound = setInitialInterval(coeffsFunc[i]);
+        double counter, derivativesPerInterval;
+        solution = WarmSolve(context, initialBound, formInterpolation, k, n, solution, counter, derivativesPerInterval);
+        const double time_taken = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        //Same format of the cold run
+        WriteSolution(solution.roots, solution.Z, time_taken, derivativesPerInterval, file);
+        file << "The order of convergence is: " << k << " " << "the level is: " << n << endl;
+        file << endl;
+        timeFile << fixed << time_taken * 1000 << setprecision(5) << " ";
+        iterationFile << counter << " ";
+    }
+    timeFile << endl;
+    iterationFile << endl;
+}
+#endif
@@ -0,0 +1,144 @@
+//Copyright(C) 2022-2023 by Brian Bronz
+#include <iostream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include "main.h"
+#include "root_finding.c++"
+#include "Polynomial_family.c++"
+using namespace std;
+
+/**
+ * @brief Write the median and the 95th percentile of the times of a phase in JSON
+ *
+ * @param name is the name of the phase
+ * @param times is the vector of the times in seconds, one for each repetition
+ * @param file is the JSON file
+ */
+void writePhase(const string name, vector<double> times, ostream &file){
+    sort(times.begin(), times.end());
+    const int size = times.size();
+    const double median = (size % 2 == 1) ? times[size / 2] : (times[size / 2 - 1] + times[size / 2]) / 2;
+    //Nearest-rank percentile
+    const double p95 = times[max(0, (int) ceil(0.95 * size) - 1)];
+    file << "\"" << name << "\": {\"median_ms\": " << median * 1000 << ", \"p95_ms\": " << p95 * 1000 << "}";
+}
+
+int main(int argc, char *argv[]){
+    //the command line can be a list of "option value":
+    // family dense, sparse or clustered; degree; count of polynomials; seed;
+    // n the level of convergence, or levels to run all the levels 1, ..., levels as createInput;
+    // warmup and repetitions of each job; output the JSON file; pruning 0 to switch off the sign-variation pruning;
+    // roots the number of real roots that every job must find, known for the clustered family
+    //regression run of a polynomial where the Taylor remainder missed a root:
+    // family dense degree 60 seed 11 levels 10 pruning 0 roots 4
+    string family = "dense";
+    int degree = 140;
+    int count = 1;
+    int seed = 1;
+    int n = 5;
+    int numLevels = 0;
+    long expectedRoots = - 1;
+    int warmup = 1;
+    int repetitions = 10;
+    string output = "benchmark.json";
+    for (int i = 1; i + 1 < argc; i += 2){
+        const string option = argv[i];
+        const string value = argv[i + 1];
+        if (option == "family"){family = value;}
+        else if (option == "degree"){degree = stoi(value);}
+        else if (option == "count"){count = stoi(value);}
+        else if (option == "seed"){seed = stoi(value);}
+        else if (option == "n"){n = stoi(value);}
+        else if (option == "levels"){numLevels = stoi(value);}
+        else if (option == "roots"){expectedRoots = stoi(value);}
+        else if (option == "warmup"){warmup = stoi(value);}
+        else if (option == "repetitions"){repetitions = max(1, stoi(value));}
+        else if (option == "output"){output = value;}
+        else if (option == "pruning"){signPruning = (stoi(value) != 0);}
+        else {
+            printf("Error: unknown option %s\n", option.c_str());
+            return 1;
+        }
+    }
+    //The same forms of createInput: Lagrange and Taylor of order 2, 3, 4
+    const vector<string> forms = {"Lagrange", "Taylor", "Taylor", "Taylor"};
+    const vector<int> orders = {1, 2, 3, 4};
+    //One level, or all the levels from the highest as createInput
+    vector<int> levels = {n};
+    if (numLevels > 0){
+        levels.clear();
+        for (int i = numLevels; i > 0; i--){
+            levels.push_back(i);
+        }
+    }
+    //The roots of the clustered family are known
+    if (expectedRoots < 0 && family == "clustered"){expectedRoots = clusteredRootCount(degree);}
+    const vector<string> phases = {"parse", "cauchy_bound", "derivatives", "eval", "taylor_f", "taylor_df", "lagrange_f", "lagrange_df", "newton"};
+    mt19937 gen(seed);
+    ofstream file;
+    file.open(output);
+    file << fixed << setprecision(6);
+    file << "{\"family\": \"" << family << "\", \"degree\": " << degree << ", \"seed\": " << seed
+        << ", \"warmup\": " << warmup << ", \"repetitions\": " << repetitions << ", \"horner_kernel\": " << hornerKernel << ", \"sign_pruning\": " << signPruning << ", \"results\": [" << endl;
+    bool missingRoots = false;
+    for (int p = 0; p < count; p++){
+        const string expression = polynomialExpression(generatePolynomial(family, degree, gen));
+        for (int job = 0; job < levels.size() * forms.size(); job++){
+            const int n = levels[job / forms.size()];
+            const int j = job % forms.size();
+            vector<vector<double> > times(phases.size());
+            double counter = 0;
+            for (int r = 0; r < warmup + repetitions; r++){
+                profile.reset();
+                chrono::steady_clock::time_point start = chrono::steady_clock::now();
+                vector<double> coeffsFunc;
+                if (!parseExpression(expression, coeffsFunc)){return 1;}
+                const double parseTime = elapsedSeconds(start);
+                start = chrono::steady_clock::now();
+                const Interval initialBound = setInitialInterval(coeffsFunc);
+                const double boundTime = elapsedSeconds(start);
+                start = chrono::steady_clock::now();
+                const PolynomialContext context(coeffsFunc, requiredDerivativeOrder(forms[j], orders[j], n));
+                const double derivativesTime = elapsedSeconds(start);
+                double derivativesPerInterval;
+                start = chrono::steady_clock::now();
+                vector<Interval> Z = Eval(context, initialBound, forms[j], orders[j], n, 1, counter, derivativesPerInterval);
+                const double evalTime = elapsedSeconds(start);
+                start = chrono::steady_clock::now();
+                refineRoots(context, Z, 100, 1e-10);
+                const double newtonTime = elapsedSeconds(start);
+                if (r < warmup){continue;}
+                const vector<double> values = {parseTime, boundTime, derivativesTime, evalTime, profile.taylorFTime,
+                    profile.taylorDfTime, profile.lagrangeFTime, profile.lagrangeDfTime, newtonTime};
+                for (int i = 0; i < phases.size(); i++){
+                    times[i].push_back(values[i]);
+                }
+            }
+            file << "  {\"polynomial\": " << p << ", \"form\": \"" << forms[j] << "\", \"k\": " << orders[j] << ", \"n\": " << n << ", \"phases\": {";
+            for (int i = 0; i < phases.size(); i++){
+                writePhase(phases[i], times[i], file);
+                file << ((i + 1 < phases.size()) ? ", " : "");
+            }
+            //All the known roots must be found
+            if (expectedRoots >= 0 && (long) profile.numRoots != expectedRoots){
+                printf("Error: %s k = %d n = %d found %ld roots of the %s polynomial, expected %ld\n", forms[j].c_str(), orders[j], n, (long) profile.numRoots, family.c_str(), expectedRoots);
+                missingRoots = true;
+            }
+            //The counters are the same for all the repetitions
+            const double newtonPerRoot = (profile.numRoots > 0) ? profile.newtonIterations / profile.numRoots : 0;
+            file << "}, \"counters\": {\"range_function_calls\": " << (long) counter << ", \"intervals_pushed\": " << (long) profile.intervalsPushed
+                << ", \"max_queue_depth\": " << (long) profile.maxQueueDepth << ", \"roots\": " << (long) profile.numRoots << ", \"expected_roots\": " << expectedRoots
+                << ", \"newton_iterations_per_root\": " << newtonPerRoot << "}}";
+            file << ((p + 1 < count || job + 1 < levels.size() * forms.size()) ? "," : "") << endl;
+        }
+    }
+    file << "]}" << endl;
+    file.close();
+    return (missingRoots) ? 1 : 0;
+}
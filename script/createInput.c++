@@ -5,49 +5,31 @@
 #include <vector>
 #include <fstream>
 #include <random>
+#include "Polynomial_family.c++"
+#include "Coefficient_file.c++"
 using namespace std;
 
-int main(){
+int main(int argc, char *argv[]){
+    //the command line can be: "degree" "family" "seed" "perturbations"
+    //family is dense (default), sparse or clustered
+    //perturbations is the number of perturbed copies of the function added to the coefficient file, for the warm mode of main
+    int numPerturbations = (argc > 4) ? stoi(argv[4]) : 0;
+    int numb = (argc > 1) ? stoi(argv[1]) : 140;
+    string family = (argc > 2) ? argv[2] : "dense";
     ofstream outputFile;
     outputFile.open("test_input_expression");
+    //the same functions are also written in the binary coefficient file
+    vector<vector<double> > rows;
     //the structure of each function must be:
-    int numb = 140;
-    int n = 100;
     for (int p = 0; p < 1; p++){
         std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<> dis(1, 10);
-        vector<double> vectorCoefficients;
-        for (int i = 0; i <= numb; i++){
-            //random value between 100 150
-            double coefficients = dis(gen);
-            //Set the pre cision to 0 decimal places
-            coefficients = (int)coefficients;
-            vectorCoefficients.push_back(coefficients);
+        std::mt19937 gen((argc > 3) ? stoi(argv[3]) : rd());
+        rows.push_back(generatePolynomial(family, numb, gen));
+        string function = polynomialExpression(rows.back());
+        //each copy perturbs the previous one by at most 1e-6 relative to each coefficient
+        for (int i = 0; i < numPerturbations; i++){
+            rows.push_back(perturbedPolynomial(rows.back(), 1e-6, gen));
         }
-        vector<string> sign;
-        for (int i = 0; i <= numb; i++){
-            if (rand() % 2 == 0){
-                sign.push_back(" - ");
-            } else {
-                sign.push_back(" + ");
-            }
-        }
-    //create a set of functions starting with 20 coefficients and then decrease the number of coefficients, which the first coefficient is always 1
-        string function = "";
-        n = 20;
-        for (int i = numb; i >= 0; i--){
-            string sign2 = sign[i];
-            if (i == 0){
-                function = function + sign2 + to_string(vectorCoefficients[i]);
-            } else if (i == 1){
-                function = function + sign2 + to_string(vectorCoefficients[i]) + "x";
-            } else {
-                function = function + sign2 + to_string(vectorCoefficients[i]) + "x^" + to_string(i);
-            }
-            n--;
-        }
-        function = function.substr(1);
         for (int i = 10; i > 0; i--){
              outputFile << "\""<< function <<"\"" << " " << "\"" << "Lagrange" << "\"" << " " << "\"" << to_string(1) << "\"" << " " << "\"" << to_string(i) <<"\"" << endl;
             outputFile << "\""<< function <<"\"" << " " << "\"" << "Taylor" << "\"" << " " << "\"" << to_string(2) << "\"" << " " << "\"" << to_string(i) <<"\"" << endl;
@@ -81,4 +63,5 @@ int main(){
         n--;
     } */
     outputFile.close();
+    writeCoefficientFile("test_coefficients.bin", rows);
 }
\ No newline at end of file
@@ -5,10 +5,84 @@
 #include <string>
 #include <vector>
 #include <fstream>
+#include <thread>
 #include "main.h"
 #include "root_finding.c++"
 using namespace std;
-int main(){
+int main(int argc, char *argv[]){
+    //the command line can be:
+    // "threads" to use more threads in the Eval algorithm
+    // speedup "maxThreads" to write the speedup table of the Eval algorithm
+    // batch "workers" to solve all the expressions concurrently
+    // coefficients "path" "interpolation form" "k" "n" "workers" to solve all the functions of a coefficient file
+    // warm "path" "interpolation form" "k" "n" to solve the functions of a coefficient file as a sequence,
+    //  each of them warm-started from the roots of the previous one
+    //and all of them can end with nopruning to switch off the sign-variation pruning of the Eval algorithm
+    if (argc > 1 && string(argv[argc - 1]) == "nopruning"){
+        signPruning = false;
+        argc--;
+    }
+    int numThreads = 1;
+    int numWorkers = 1;
+    bool speedup = false;
+    bool batch = false;
+    if (argc > 1 && string(argv[1]) == "speedup"){
+        speedup = true;
+        numThreads = (argc > 2) ? stoi(argv[2]) : max(1, (int) thread::hardware_concurrency());
+    } else if (argc > 1 && string(argv[1]) == "batch"){
+        batch = true;
+        numWorkers = (argc > 2) ? stoi(argv[2]) : max(1, (int) thread::hardware_concurrency());
+    } else if (argc > 5 && (string(argv[1]) == "coefficients" || string(argv[1]) == "warm")){
+        //The functions are already in coefficient form, no expression is parsed
+        vector<double> coeffs;
+        vector<long> offsets;
+        if (!readCoefficientFile(argv[2], coeffs, offsets)){
+            printf("Error: cannot read the coefficient file %s\n", argv[2]);
+            return 1;
+        }
+        const string interpolationForm = argv[3];
+        const int k = stoi(argv[4]);
+        const int n = stoi(argv[5]);
+        const bool warm = (string(argv[1]) == "warm");
+        numWorkers = (argc > 6) ? stoi(argv[6]) : max(1, (int) thread::hardware_concurrency());
+        vector<vector<double> > coeffsFunc;
+        vector<Interval> initialBound;
+        vector<BatchJob> jobs;
+        vector<int> jobPolynomial;
+        vector<string> expressions;
+        for (int i = 0; i + 1 < offsets.size(); i++){
+            coeffsFunc.push_back(vector<double>(coeffs.begin() + offsets[i], coeffs.begin() + offsets[i + 1]));
+            //The leading zeros are removed, a row without nonzero coefficients fails its job
+            expressions.push_back(polynomialExpression(coeffsFunc[i]));
+            if (normalizeCoefficients(coeffsFunc[i])){
+                expressions[i] = polynomialExpression(coeffsFunc[i]);
+                initialBound.push_back(setInitialInterval(coeffsFunc[i]));
+            } else {
+                printf("Error: the row %d of the coefficient file has no nonzero coefficient\n", i + 1);
+                coeffsFunc[i].clear();
+                initialBound.push_back(Interval(0, 0));
+            }
+            jobs.push_back(BatchJob(expressions[i], interpolationForm, k, n, numThreads));
+            jobPolynomial.push_back(i);
+        }
+        ofstream outputFile;
+        outputFile.open("roots.txt");
+        ofstream timeTaken;
+        timeTaken.open("AverageTime.txt");
+        ofstream myfile;
+        myfile.open("iterations.txt");
+        if (warm){
+            SolveSequence(coeffsFunc, expressions, interpolationForm, k, n, outputFile, timeTaken, myfile);
+        } else {
+            SolveBatch(jobs, jobPolynomial, coeffsFunc, initialBound, numWorkers, outputFile, timeTaken, myfile);
+        }
+        outputFile.close();
+        timeTaken.close();
+        myfile.close();
+        return 0;
+    } else if (argc > 1){
+        numThreads = stoi(argv[1]);
+    }
     //read from file
     string inputLine;
     ifstream file;
@@ -20,14 +94,15 @@ int main(){
     timeTaken.open("AverageTime.txt");
     ofstream myfile;
     myfile.open("iterations.txt");
+    ofstream speedupFile;
+    if (speedup){speedupFile.open("speedup.txt");}
+    vector<BatchJob> jobs;
     while(getline(file, inputLine)){
-        outputFile << "expression: ";
         //the structure of each function must be:
-        // "function" "interpolation form" "k" "n"
+        // "function" "interpolation form" "k" "n" and optionally "threads"
         //Get the expression
         int idxExpression = inputLine.find("\"", 1);
         string expression = inputLine.substr(1, idxExpression - 1);
-        outputFile << expression << endl;
         //Get the interpolation form
         int idxInterpolationForm = inputLine.find("\"", idxExpression + 3);
         string interpolationForm = inputLine.substr(idxExpression + 3, idxInterpolationForm - idxExpression - 3);
@@ -37,14 +112,26 @@ int main(){
         //Get the level of convergence
         int idxN = inputLine.find("\"", idxK + 3);
         int n = stoi(inputLine.substr(idxK + 2, idxN - idxK - 2));
+        //Get the number of threads, if it is given
+        int idxThreads = inputLine.find("\"", idxN + 1);
+        int lineThreads = (idxThreads != -1) ? stoi(inputLine.substr(idxThreads + 1)) : numThreads;
+        if (speedup && (interpolationForm == "Taylor" || interpolationForm == "Lagrange")){
+            SpeedupTable(expression, interpolationForm, k, n, numThreads, speedupFile);
+            continue;
+        }
+        if (batch && (interpolationForm == "Taylor" || interpolationForm == "Lagrange")){
+            jobs.push_back(BatchJob(expression, interpolationForm, k, n, lineThreads));
+            continue;
+        }
+        outputFile << "expression: " << expression << endl;
         //Get the roots using the interpolation form
         if (interpolationForm == "Taylor"){
-            FindingRoots(expression, "Taylor", k, n, outputFile, timeTaken, myfile);
+            FindingRoots(expression, "Taylor", k, n, lineThreads, outputFile, timeTaken, myfile);
         }
         else if (interpolationForm == "Lagrange"){
             timeTaken << endl;
             myfile << endl;
-            FindingRoots(expression, "Lagrange", k, n, outputFile, timeTaken, myfile);
+            FindingRoots(expression, "Lagrange", k, n, lineThreads, outputFile, timeTaken, myfile);
         } else {
             printf("Error: Taylor or Lagrange form not specified\n");
             break;
@@ -53,7 +140,11 @@ int main(){
         outputFile << endl;
         //timeTaken << endl;
     }
+    if (batch){
+        RunBatch(jobs, numWorkers, outputFile, timeTaken, myfile);
+    }
     myfile.close();
+    speedupFile.close();
     file.close();
     timeTaken.close();
 }
\ No newline at end of file
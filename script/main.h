@@ -3,7 +3,13 @@
 #include <cmath>
 #include <vector>
 #include <iostream>
+#include <fstream>
 #include <limits>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
 #ifndef MAIN_H
 #define MAIN_H
 using namespace std;
@@ -23,41 +29,132 @@ class Interval{
         void setB(const double leftExactPart, const double rightExactPart, const double left_app_part, const double right_app_part);
 };
 
-class RangeFunc{
-    protected:
+class PolynomialContext{
+    private:
+        vector<vector<double> > derivatives;
+        vector<double> factorials;
+        vector<double> zeroPolynomial = {0};
+
+    public:
+        vector<double> coeffsFunc;
+        int degree;
+
+        PolynomialContext(const vector<double> coeffsFunc, const int maxOrder);
+        const vector<double> &getDerivative(const int i) const;
+        double getFactorial(const int i) const;
+};
+
+class WorkDeque{
+    private:
+        deque<Interval> intervals;
+        mutex lock;
+
+    public:
+        void push(Interval I);
+        bool pop(Interval &I);
+        bool steal(Interval &I);
+};
+
+//Subintervals of the parallel Eval algorithm not yet evaluated, the idle threads sleep until some of them are pushed
+class WorkSignal{
+    private:
+        mutex lock;
+        condition_variable changed;
+        atomic<int> waiting;
+
+    public:
+        atomic<long> pending;
+        atomic<long> queued;
+
+        WorkSignal(const long pending);
+        void wait();
+        void notify();
+};
+
+class Root{
+    public:
+        double value;
         double a;
         double b;
+        int iterations;
+        double residual;
+        bool converged;
 
-        RangeFunc(const double a, const double b);
-        virtual Interval getDf(Interval I, const int n, const int k);
-        virtual Interval getF(Interval I, const int n, const int k);
+        Root(const double value, const double a, const double b);
 };
 
-class TaylorInterpolation: public RangeFunc{
-    private:
+//Isolating subintervals and roots of a polynomial function, with the subintervals where it has no roots:
+//they are the hints of the solution of a close polynomial function
+class Solution{
+    public:
         vector<double> coeffsFunc;
-        Interval approximateInterval = Interval(0, 0);
+        vector<Interval> Z;
+        vector<Root> roots;
+        vector<Interval> freeIntervals;
+        vector<double> margins;
+};
+
+class BatchJob{
+    public:
+        string expression;
+        string interpolationForm;
+        int k;
+        int n;
+        int numThreads;
 
+        BatchJob(const string expression, const string interpolationForm, const int k, const int n, const int numThreads);
+};
+
+class PhaseProfile{
     public:
-        TaylorInterpolation(const vector<double> coeffsFunc, Interval S_kn, const double a, const double b);
-        Interval g_k1(vector<double> coeffsFunc, const int k, Interval I, const bool Df);
-        Interval S_kn(const int k, const int n, Interval I, vector<double> coeffsFunc, const bool Df);
-        virtual Interval getDf(Interval I, const int n, const int k);
-        virtual Interval getF(Interval I, const int n, const int k);
+        double taylorFTime;
+        double taylorDfTime;
+        double lagrangeFTime;
+        double lagrangeDfTime;
+        double intervalsPushed;
+        double maxQueueDepth;
+        double numRoots;
+        double newtonIterations;
+
+        PhaseProfile();
+        void reset();
+        void addRangeFunction(const bool taylor, const bool dF, const chrono::steady_clock::time_point start);
 };
 
-class LagrangeInterpolation: public RangeFunc{
+//Values f^{(i)}(x) in the points of a frontier, stored by order of the derivative
+class FrontierValues{
     private:
-        vector<double> coeffsFunc;
-        double approxInterval;
+        const vector<vector<double> > *values;
+        int p;
 
     public:
-        LagrangeInterpolation(const vector<double> coeffsFunc, const double approxInterval, double a, double b);
-        vector<double> h_j(const int j, Interval I);
-        double T_kn(const int n, Interval I);
-        Interval quadratic_polynomials(Interval I, const vector<double> h_0);
-        virtual Interval getDf(Interval I, const int n, const int k);
-        virtual Interval getF(Interval I, const int n, const int k);
+        FrontierValues(const vector<vector<double> > &values, const int p);
+        double operator()(const int i) const;
+};
+
+//Values f^{(i)}(x) in a single point, evaluated when they are needed
+class PointValues{
+    private:
+        const PolynomialContext *context;
+        int step;
+        double x;
+
+    public:
+        PointValues(const PolynomialContext &context, const int step, const double x);
+        double operator()(const int i) const;
+};
+
+//Range functions specialised for a form and an order of convergence
+typedef void (*FrontierRange)(const vector<Interval> &frontier, const PolynomialContext &context, const int n, const bool dF, vector<Interval> &ranges);
+typedef Interval (*PointRange)(Interval I, const PolynomialContext &context, const int n, const bool dF);
+
+class RangeKernel{
+    public:
+        bool taylor;
+        FrontierRange frontierRange;
+        PointRange pointRange;
+
+        RangeKernel(const string formInterpolation, const int k);
 };
 
 //declare all methods here
@@ -67,22 +164,54 @@ double checkSign(const double value, const string sign);
 
 vector<vector<double> > parseFunc(const string func, vector<double> coeffsFunc, vector<double> powers, int idxVector, const int idx_x, const int i, const string sign);
 vector<double> parsePolynomial(const string func, string sign);
+bool parseExpression(const string &func, vector<double> &coeffsFunc);
 string sortPolynomialFunct(string func);
 
 //Descarte's rule
-int NumPositiveRoots(const vector<string> vectorSign);
-int NumNegativeRoots(const vector<string> vectorSign, const vector<double> vectorPower); 
-bool existRealRoots(const string func, string sign);
+extern bool signPruning;
+int signVariations(const vector<double> &coeffsFunc);
+vector<double> reflectedCoefficients(const vector<double> &coeffsFunc);
+int NumPositiveRoots(const vector<double> &coeffsFunc);
+int NumNegativeRoots(const vector<double> &coeffsFunc);
+bool existRealRoots(const vector<double> &coeffsFunc);
+double positiveRootBound(const vector<double> &coeffsFunc);
+vector<Interval> initialIntervals(const vector<double> &coeffsFunc, Interval initialBound);
+template <int L> void blockSignVariations(const vector<double> &coeffsFunc, const Interval *intervals, int *variations);
+void intervalSignVariations(const vector<double> &coeffsFunc, const vector<Interval> &intervals, vector<int> &variations);
+void descartesTest(const PolynomialContext &context, const vector<Interval> &intervals, vector<int> &results);
+int descartesTest(const PolynomialContext &context, Interval J);
+
+//Profiling
+extern thread_local PhaseProfile profile;
+double elapsedSeconds(const chrono::steady_clock::time_point start);
 
 //Cauchy's bounds
 Interval setInitialInterval(const vector<double> coeffsFunc); //Tested (simple)
 
+//Derivatives shared by the range functions
+int requiredDerivativeOrder(const string formInterpolation, const int k, const int n);
+
+//Range functions
+template <int K, bool Df, class Values> Interval taylorRange(const Values &values, Interval I, const PolynomialContext &context, const int n);
+template <int K> void taylorFrontier(const vector<Interval> &frontier, const PolynomialContext &context, const int n, const bool dF, vector<Interval> &ranges);
+template <int K> Interval taylorPoint(Interval I, const PolynomialContext &context, const int n, const bool dF);
+Interval quadraticRange(const double r, const double c0, const double c1, const double c2);
+template <bool Df, class Values> Interval lagrangeRange(const Values &f_a, const Values &f_m, const Values &f_b, Interval remainder, Interval I, const PolynomialContext &context, const int n);
+void lagrangeFrontier(const vector<Interval> &frontier, const PolynomialContext &context, const int n, const bool dF, vector<Interval> &ranges);
+Interval lagrangePoint(Interval I, const PolynomialContext &context, const int n, const bool dF);
+
 //Eval algorithm
-Interval Interpolation(const double a, const double b, const vector<double> coeffsFunc, const string formInterpolation, const int k, const int n, const bool dF);
 vector<double> kDerivative(vector<double> coeffsFunc, const int k);
-double functionValue(const vector<double> coeffsFunc, const double xPoint);
-Interval functionValue(const vector<double> coeffsFunc, Interval I);
-vector<Interval> Eval(const vector<double> coeffsFunc, Interval initialBound, const string formInterpolation, const int k, const int n);
+double functionValue(const vector<double> &coeffsFunc, const double xPoint);
+Interval functionValue(const vector<double> &coeffsFunc, Interval I);
+Interval functionRange(const vector<double> &coeffsFunc, Interval I);
+void functionValues(const vector<double> &coeffsFunc, const vector<double> &xPoints, vector<double> &values);
+void functionValues(const vector<double> &coeffsFunc, const vector<double> &lower, const vector<double> &upper, vector<double> &resLower, vector<double> &resUpper);
+bool canVanish(Interval range, const double f_a, const double f_b);
+int evalInterval(const PolynomialContext &context, Interval J, const RangeKernel &kernel, const int n, double &counter);
+vector<Interval> Eval(const PolynomialContext &context, Interval initialBound, const string formInterpolation, const int k, const int n, const int numThreads, double &counter, double &derivativesPerInterval);
+vector<Interval> EvalFrontier(const PolynomialContext &context, vector<Interval> frontier, const RangeKernel &kernel, const int n, const int numThreads, double &counter, double &derivativesPerInterval, vector<Interval> &freeIntervals, vector<double> &margins);
+vector<Interval> ParallelEval(const PolynomialContext &context, const vector<Interval> &intervals, const RangeKernel &kernel, const int n, const int numThreads, double &counter, double &derivativesPerInterval);
 
 Interval Sum(Interval I, const double cons);
 Interval Sum(Interval I, Interval J);
@@ -90,8 +219,26 @@ Interval MultiConstant(Interval I, const double cons);
 Interval Multiplication(Interval I, Interval J);
 Interval Substraction(Interval I, const double cons);
 //Newton's method
-void getRoots(const vector<double> coeffsFunc, vector<Interval> Z, const int maxIterations, const double tolerance, const double epsilon, const bool firstIteration, ofstream &file);
+vector<Root> refineRoots(const PolynomialContext &context, const vector<Interval> &Z, const int maxIterations, const double tolerance);
+vector<Root> refineRoots(const PolynomialContext &context, const vector<Interval> &Z, const vector<double> &start, const int maxIterations, const double tolerance);
+//Warm start from the roots of a close polynomial function
+void perturbationBounds(const vector<double> &coeffsFunc, const vector<double> &previousCoeffs, const vector<Interval> &intervals, vector<double> &bounds);
+vector<Interval> WarmEval(const PolynomialContext &context, Interval initialBound, const string formInterpolation, const int k, const int n, const Solution &previous, vector<int> &hintIdx, Solution &solution, double &counter, double &derivativesPerInterval);
+Solution WarmSolve(const PolynomialContext &context, Interval initialBound, const string formInterpolation, const int k, const int n, const Solution &previous, double &counter, double &derivativesPerInterval);
+void SolveSequence(const vector<vector<double> > &coeffsFunc, const vector<string> &expressions, const string formInterpolation, const int k, const int n, ostream &file, ostream &timeFile, ostream &iterationFile);
 
 //Root finding algorithm
-void FindingRoots(string func, const string formInterpolation, const int k, const int n, ofstream &file);
+void FindingRoots(string func, const string formInterpolation, const int k, const int n, const int numThreads, ostream &file, ostream &timeFile, ostream &iterationFile);
+void WriteSolution(const vector<Root> &roots, const vector<Interval> &Z, const double time_taken, const double derivativesPerInterval, ostream &file);
+void SolveRoots(const vector<double> coeffsFunc, const Interval initialBound, const string formInterpolation, const int k, const int n, const int numThreads, ostream &file, ostream &timeFile, ostream &iterationFile);
+//Batch of root finding jobs
+void SolveJob(const BatchJob &job, const vector<double> coeffsFunc, const Interval initialBound, ostream &file, ostream &timeFile, ostream &iterationFile);
+void RunBatch(const vector<BatchJob> jobs, const int numWorkers, ostream &file, ostream &timeFile, ostream &iterationFile);
+void SolveBatch(const vector<BatchJob> &jobs, const vector<int> &jobPolynomial, const vector<vector<double> > &coeffsFunc, const vector<Interval> &initialBound, const int numWorkers, ostream &file, ostream &timeFile, ostream &iterationFile);
+
+//Coefficient files
+bool readCoefficientFile(const string path, vector<double> &coeffsFunc, vector<long> &offsets);
+bool normalizeCoefficients(vector<double> &coeffsFunc);
+void writeCoefficientFile(const string path, const vector<vector<double> > rows);
+void SpeedupTable(string func, const string formInterpolation, const int k, const int n, const int maxThreads, ofstream &file);
 #endif
\ No newline at end of file
@@ -6,13 +6,23 @@
 #include <limits>
 #include <fstream>
 #include "main.h"
+#include "Profile.c++"
 #include "Cauchy.c++"
+#include "Descartes.c++"
 #include "Evaluate.c++"
+#include "Horner.c++"
+#include "Polynomial_context.c++"
+#include "Parallel_eval.c++"
+#include "Batch.c++"
+#include "Coefficient_file.c++"
+#include "Polynomial_family.c++"
 #include "Lagrange_form.c++"
 #include "Parsing.c++"
 #include "Taylor_form.c++"
+#include "Range_function.c++"
 #include "Newton.c++"
-#include <ctime>
+#include "Warm_start.c++"
+#include <chrono>
 using namespace std;
 
 /**
@@ -22,35 +32,81 @@ using namespace std;
  * @param formInterpolation is string that indicates the form of the interpolation, i.e. Taylor or Lagrange 
  * @param k is the level of convergence
  * @param n is the order of convergence
+ * @param numThreads is the number of threads used by the Eval algorithm
  * @param file is the file where the results are written
+ * @param timeFile is the file where the average time is written
+ * @param iterationFile is the file where the number of range function evaluations is written
  */
-void FindingRoots(string func, const string formInterpolation, const int k, const int n, ofstream &file, ofstream &timeFile, ofstream &iterationFile){
-    clock_t start, end;
+void FindingRoots(string func, const string formInterpolation, const int k, const int n, const int numThreads, ostream &file, ostream &timeFile, ostream &iterationFile){
+    //Get the coefficients of the function, the job fails if the expression is not valid
+    vector<double> coeffsFunc;
+    if (!parseExpression(func, coeffsFunc)){
+        file << "The expression cannot be parsed" << endl;
+        return;
+    }
+    //Set the initial interval
+    const Interval initialBound = setInitialInterval(coeffsFunc);
+    SolveRoots(coeffsFunc, initialBound, formInterpolation, k, n, numThreads, file, timeFile, iterationFile);
+}
+
+/**
+ * @brief Write the roots with their subintervals, the time and the derivatives of a polynomial function f(x)
+ * 
+ * @param roots is the vector of the roots
+ * @param Z is the vector of the subintervals, each of them with one root
+ * @param time_taken is the time in seconds
+ * @param derivativesPerInterval is the number of derivatives computed for each subinterval
+ * @param file is the file where the results are written, it is left in fixed notation
+ */
+void WriteSolution(const vector<Root> &roots, const vector<Interval> &Z, const double time_taken, const double derivativesPerInterval, ostream &file){
+    for (int i = 0; i < roots.size(); i++){
+        file << "The root is " << roots[i].value << " in the interval [" << Z[i].a << ", " << Z[i].b << "]" " in " << roots[i].iterations << " iterations";
+        file << ((roots[i].converged) ? "\n" : " (not converged)\n");
+    }
+    file << "Time taken by program is : " << fixed << time_taken << setprecision(5) << " sec " << endl;
+    file << "Derivatives computed per subinterval: " << derivativesPerInterval << endl;
+}
+
+/**
+ * @brief Find all the real roots of an already parsed polynomial function f(x)
+ * 
+ * @param coeffsFunc is the coefficients of the function f(x)
+ * @param initialBound is the interval containing all real roots
+ * @param formInterpolation is string that indicates the form of the interpolation, i.e. Taylor or Lagrange 
+ * @param k is the level of convergence
+ * @param n is the order of convergence
+ * @param numThreads is the number of threads used by the Eval algorithm
+ * @param file is the file where the results are written
+ * @param timeFile is the file where the average time is written
+ * @param iterationFile is the file where the number of range function evaluations is written
+ */
+void SolveRoots(const vector<double> coeffsFunc, const Interval initialBound, const string formInterpolation, const int k, const int n, const int numThreads, ostream &file, ostream &timeFile, ostream &iterationFile){
+    //Wall-clock time, the CPU time would add up the time of all the threads
+    chrono::steady_clock::time_point start, end;
     int numIterations = 2;
     bool firstIteration = true;
     vector<double> timeTaken;
-    //Sort the expression in case of a polynomial function
-    func = sortPolynomialFunct(func);
-    //Get the coefficients of the function
-    const vector<double> coeffsFunc = parsePolynomial(func, "+");
-    //Set the initial interval
-    const Interval initialBound = setInitialInterval(coeffsFunc);
+    //Compute the derivatives once for all the subintervals
+    const PolynomialContext context(coeffsFunc, requiredDerivativeOrder(formInterpolation, k, n));
+    double derivativesPerInterval = 0;
     while(numIterations > 0){
         //EVAL algorithm
-        start = clock();
-        vector<Interval> Z = Eval(coeffsFunc, initialBound, formInterpolation, k, n, iterationFile);
+        start = chrono::steady_clock::now();
+        double counter;
+        vector<Interval> Z = Eval(context, initialBound, formInterpolation, k, n, numThreads, counter, derivativesPerInterval);
+        iterationFile << counter << " ";
         //Get the real roots of the function
         const int maxIterations = 100;
         const double tolerance = 1e-10;
-        const double epsilon = 1e-10;
-        getRoots(coeffsFunc, Z, maxIterations, tolerance, epsilon,  firstIteration, file);
-        Z.clear();
-        end = clock();
-        const double time_taken = double(end - start) / double(CLOCKS_PER_SEC);
+        const vector<Root> roots = refineRoots(context, Z, maxIterations, tolerance);
+        end = chrono::steady_clock::now();
+        const double time_taken = chrono::duration<double>(end - start).count();
+        //write the root and the interval in the file
         if (firstIteration){
-            file << "Time taken by program is : " << fixed << time_taken << setprecision(5) << " sec " << endl;
+            WriteSolution(roots, Z, time_taken, derivativesPerInterval, file);
             firstIteration = false;
         }
+        Z.clear();
         timeTaken.push_back(time_taken);
         numIterations--;
     }
@@ -63,4 +119,54 @@ void FindingRoots(string func, const string formInterpolation, const int k, cons
     timeFile << fixed << AverageTime * 1000 << setprecision(5) << " ";
     //timeFile << "Average time taken by program is : " << fixed << AverageTime * 1000 << setprecision(5) << " ms " << endl;
     timeTaken.clear();
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Measure the speedup of the Eval algorithm for an increasing number of threads
+ * 
+ * @param func is the trigonometric polynomial function
+ * @param formInterpolation is string that indicates the form of the interpolation, i.e. Taylor or Lagrange 
+ * @param k is the level of convergence
+ * @param n is the order of convergence
+ * @param maxThreads is the maximum number of threads
+ * @param file is the file where the table is written
+ */
+void SpeedupTable(string func, const string formInterpolation, const int k, const int n, const int maxThreads, ofstream &file){
+    const int numRepetitions = 3;
+    vector<double> coeffsFunc;
+    if (!parseExpression(func, coeffsFunc)){
+        file << formInterpolation << " k = " << k << " n = " << n << endl;
+        file << "The expression cannot be parsed" << endl;
+        return;
+    }
+    const Interval initialBound = setInitialInterval(coeffsFunc);
+    const PolynomialContext context(coeffsFunc, requiredDerivativeOrder(formInterpolation, k, n));
+    //Number of threads: 1, 2, 4, ..., maxThreads
+    vector<int> numThreads;
+    for (int i = 1; i < maxThreads; i *= 2){
+        numThreads.push_back(i);
+    }
+    numThreads.push_back(maxThreads);
+    file << formInterpolation << " k = " << k << " n = " << n << endl;
+    file << "threads time(ms) speedup efficiency" << endl;
+    //All the rows use the work-stealing subdivision, also with one thread, so that the speedup compares the same algorithm
+    const RangeKernel kernel(formInterpolation, k);
+    const vector<Interval> intervals = initialIntervals(coeffsFunc, initialBound);
+    double serialTime = 0;
+    for (int i = 0; i < numThreads.size(); i++){
+        //Keep the best time of the repetitions
+        double bestTime = numeric_limits<double>::max();
+        for (int j = 0; j < numRepetitions; j++){
+            double counter = 0;
+            double derivativesPerInterval;
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            ParallelEval(context, intervals, kernel, n, numThreads[i], counter, derivativesPerInterval);
+            chrono::steady_clock::time_point end = chrono::steady_clock::now();
+            bestTime = min(bestTime, chrono::duration<double>(end - start).count());
+        }
+        if (i == 0){serialTime = bestTime;}
+        const double speedup = serialTime / bestTime;
+        file << numThreads[i] << " " << fixed << setprecision(5) << bestTime * 1000 << " " << speedup << " " << speedup / numThreads[i] << endl;
+    }
+    file << endl;
+}